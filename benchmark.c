@@ -0,0 +1,371 @@
+/*******************************************************************************
+* File Name:   benchmark.c
+*
+* Description: Startup benchmark of the arithmetic kernels: cycles per call,
+*              measured with the SysTick timer. Compiles out when disabled.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "cybsp.h"
+#include "benchmark.h"
+#include "hall_angle.h"
+#include "hall_filter.h"
+#include "hall_spectrum.h"
+#include "hall_speed.h"
+#include "hall_stream.h"
+#include <stdio.h>
+
+#if ENABLE_BENCHMARK
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Calls per measurement of the short kernels, with interrupts disabled. A
+ * measurement must be shorter than one SysTick period */
+#define BENCHMARK_CALLS                     (16U)
+
+/* Measurements per kernel; the fastest one is reported */
+#define BENCHMARK_RUNS                      (8U)
+
+/* Sector times filtered per call of the filter kernels */
+#define BENCHMARK_FILTER_SAMPLES            (4U)
+
+/* Sector time fed to the speed spectrum kernel in speed timer ticks */
+#define BENCHMARK_SPECTRUM_TICKS            (1000U)
+
+/* Sector time fed to the edge stream kernel, plus up to 31 ticks of noise
+ * from the arguments */
+#define BENCHMARK_STREAM_TICKS              (5000U)
+
+/*******************************************************************************
+* Data structure and enumeration
+*******************************************************************************/
+typedef uint32_t (*benchmark_kernel_t)(uint32_t argument);
+
+typedef struct
+{
+    const char *name;
+    benchmark_kernel_t kernel;
+    uint32_t calls;             /* Calls per measurement */
+} benchmark_entry_t;
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* Sector times from standstill to the top speed of the example. Read through
+ * a volatile so that the compiler cannot fold the kernels */
+static volatile uint32_t benchmark_arguments[BENCHMARK_CALLS] =
+{
+    3U, 7U, 12U, 25U, 50U, 99U, 180U, 333U,
+    700U, 1250U, 2600U, 5000U, 9999U, 20000U, 40000U, 65535U
+};
+
+/* Keeps the results of the kernels alive */
+static volatile uint32_t benchmark_sink;
+
+/*******************************************************************************
+* Function Name: benchmark_empty
+********************************************************************************
+* Summary:
+*  Empty kernel, measures the loop and call overhead.
+*
+*******************************************************************************/
+static uint32_t benchmark_empty(uint32_t argument)
+{
+    return argument;
+}
+
+/*******************************************************************************
+* Function Name: benchmark_library_div
+********************************************************************************
+* Summary:
+*  Speed conversion with the division of the C library.
+*
+*******************************************************************************/
+static uint32_t benchmark_library_div(uint32_t argument)
+{
+    return 60000000U / argument;
+}
+
+/*******************************************************************************
+* Function Name: benchmark_reciprocal_div
+********************************************************************************
+* Summary:
+*  Speed conversion with the reciprocal division.
+*
+*******************************************************************************/
+static uint32_t benchmark_reciprocal_div(uint32_t argument)
+{
+    return hall_speed_udiv_reciprocal(60000000U, argument);
+}
+
+#if ENABLE_MATH_COPROCESSOR && defined(MATH)
+/*******************************************************************************
+* Function Name: benchmark_math_div
+********************************************************************************
+* Summary:
+*  Speed conversion with the MATH coprocessor divider.
+*
+*******************************************************************************/
+static uint32_t benchmark_math_div(uint32_t argument)
+{
+    return hall_speed_udiv(60000000U, argument);
+}
+
+/*******************************************************************************
+* Function Name: benchmark_cordic_sin
+********************************************************************************
+* Summary:
+*  Sine of an electrical angle with the MATH coprocessor CORDIC.
+*
+*******************************************************************************/
+static uint32_t benchmark_cordic_sin(uint32_t argument)
+{
+    return (uint32_t)hall_angle_sin((uint16_t)(argument * 997U));
+}
+#endif
+
+/*******************************************************************************
+* Function Name: benchmark_table_sin
+********************************************************************************
+* Summary:
+*  Sine of an electrical angle from the quarter wave table.
+*
+*******************************************************************************/
+static uint32_t benchmark_table_sin(uint32_t argument)
+{
+    return (uint32_t)hall_angle_sin_table((uint16_t)(argument * 997U));
+}
+
+#if ENABLE_CMSIS_DSP_FILTER
+/*******************************************************************************
+* Function Name: benchmark_filter
+********************************************************************************
+* Summary:
+*  Filters and decimates BENCHMARK_FILTER_SAMPLES sector times, with the
+*  CMSIS-DSP kernel on XMC4000 devices.
+*
+*******************************************************************************/
+static uint32_t benchmark_filter(uint32_t argument)
+{
+    uint32_t block[BENCHMARK_FILTER_SAMPLES];
+    uint32_t i;
+
+    for (i = 0U; i < BENCHMARK_FILTER_SAMPLES; i++)
+    {
+        block[i] = argument;
+    }
+
+    return hall_filter_process(block, block, BENCHMARK_FILTER_SAMPLES);
+}
+
+/*******************************************************************************
+* Function Name: benchmark_filter_c
+********************************************************************************
+* Summary:
+*  Filters BENCHMARK_FILTER_SAMPLES sector times with the C biquad.
+*
+*******************************************************************************/
+static uint32_t benchmark_filter_c(uint32_t argument)
+{
+    static int32_t state[HALL_FILTER_NUM_STATES];
+    int32_t block[BENCHMARK_FILTER_SAMPLES];
+    uint32_t i;
+
+    for (i = 0U; i < BENCHMARK_FILTER_SAMPLES; i++)
+    {
+        block[i] = (int32_t)(argument << 14);
+    }
+    hall_filter_biquad_c(block, BENCHMARK_FILTER_SAMPLES, state);
+
+    return (uint32_t)block[BENCHMARK_FILTER_SAMPLES - 1U];
+}
+#endif
+
+#if ENABLE_SPEED_SPECTRUM
+/*******************************************************************************
+* Function Name: benchmark_spectrum
+********************************************************************************
+* Summary:
+*  Resamples sector times until a block is complete and analysed, i.e. the
+*  cost of one FFT block including the resampling.
+*
+*******************************************************************************/
+static uint32_t benchmark_spectrum(uint32_t argument)
+{
+    uint32_t ticks = BENCHMARK_SPECTRUM_TICKS;
+
+    (void)argument;
+    while (!hall_spectrum_process(&ticks, 1U))
+    {
+    }
+
+    return ticks;
+}
+#endif
+
+#if ENABLE_EDGE_STREAM
+/*******************************************************************************
+* Function Name: benchmark_stream
+********************************************************************************
+* Summary:
+*  Encodes a noisy sector time into the edge stream and reads it back, so
+*  that the buffer does not run full.
+*
+*******************************************************************************/
+static uint32_t benchmark_stream(uint32_t argument)
+{
+    uint8_t record[HALL_STREAM_KEYFRAME_LENGTH + 1U];
+
+    hall_stream_push(BENCHMARK_STREAM_TICKS + (argument & 0x1FU), false);
+
+    return hall_stream_read(record, sizeof(record));
+}
+#endif
+
+static const benchmark_entry_t benchmark_entries[] =
+{
+    { "library division", benchmark_library_div, BENCHMARK_CALLS },
+    { "reciprocal division", benchmark_reciprocal_div, BENCHMARK_CALLS },
+#if ENABLE_MATH_COPROCESSOR && defined(MATH)
+    { "MATH division", benchmark_math_div, BENCHMARK_CALLS },
+#endif
+    { "table sine", benchmark_table_sin, BENCHMARK_CALLS },
+#if ENABLE_MATH_COPROCESSOR && defined(MATH)
+    { "CORDIC sine", benchmark_cordic_sin, BENCHMARK_CALLS },
+#endif
+#if ENABLE_CMSIS_DSP_FILTER
+    { "filter, 4 sector times", benchmark_filter, BENCHMARK_CALLS },
+    { "C biquad, 4 sector times", benchmark_filter_c, BENCHMARK_CALLS },
+#endif
+#if ENABLE_SPEED_SPECTRUM
+    { "speed spectrum, 1 block", benchmark_spectrum, 1U },
+#endif
+#if ENABLE_EDGE_STREAM
+    { "edge stream, 1 edge", benchmark_stream, BENCHMARK_CALLS },
+#endif
+};
+
+/*******************************************************************************
+* Function Name: benchmark_measure
+********************************************************************************
+* Summary:
+*  Measures calls of a kernel with interrupts disabled, cycling through the
+*  arguments.
+*
+* Parameters:
+*  kernel: kernel to measure
+*  calls: number of calls per measurement
+*
+* Return:
+*  uint32_t: fastest measurement in cycles
+*
+*******************************************************************************/
+static uint32_t benchmark_measure(benchmark_kernel_t kernel, uint32_t calls)
+{
+    uint32_t reload = SysTick->LOAD + 1U;
+    uint32_t fastest = UINT32_MAX;
+    uint32_t primask;
+    uint32_t start;
+    uint32_t end;
+    uint32_t run;
+    uint32_t i;
+
+    for (run = 0U; run < BENCHMARK_RUNS; run++)
+    {
+        primask = __get_PRIMASK();
+        __disable_irq();
+        start = SysTick->VAL;
+        for (i = 0U; i < calls; i++)
+        {
+            benchmark_sink = kernel(benchmark_arguments[i % BENCHMARK_CALLS]);
+        }
+        end = SysTick->VAL;
+        __set_PRIMASK(primask);
+
+        /* The SysTick timer counts down and may have wrapped once */
+        end = (start >= end) ? (start - end) : ((start + reload) - end);
+        if (end < fastest)
+        {
+            fastest = end;
+        }
+    }
+
+    return fastest;
+}
+
+/*******************************************************************************
+* Function Name: benchmark_run
+********************************************************************************
+* Summary:
+*  Measures all kernels and prints the cycles per call without the loop
+*  overhead. Must be called after the SysTick timer is started and before
+*  the hall events are enabled, so that the measurements are not disturbed.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void benchmark_run(void)
+{
+    uint32_t overhead;
+    uint32_t cycles;
+    uint32_t calls;
+    uint32_t i;
+
+    printf("Benchmark (cycles per call):\r\n");
+    for (i = 0U; i < (sizeof(benchmark_entries) / sizeof(benchmark_entries[0])); i++)
+    {
+        calls = benchmark_entries[i].calls;
+        overhead = benchmark_measure(benchmark_empty, calls);
+        cycles = benchmark_measure(benchmark_entries[i].kernel, calls);
+        cycles = (cycles > overhead) ? (cycles - overhead) : 0U;
+        printf("  %-24s %6lu\r\n", benchmark_entries[i].name, (unsigned long)(cycles / calls));
+    }
+
+    /* Discard the state the kernels left behind */
+    #if ENABLE_CMSIS_DSP_FILTER
+    hall_filter_init();
+    #endif
+    #if ENABLE_SPEED_SPECTRUM
+    hall_spectrum_init();
+    #endif
+    #if ENABLE_EDGE_STREAM
+    hall_stream_reset();
+    #endif
+}
+
+#endif /* ENABLE_BENCHMARK */
@@ -0,0 +1,188 @@
+/*******************************************************************************
+* File Name:   boot_profile.c
+*
+* Description: Boot time profiling: timestamps of the startup phases from reset
+*              to the first reported speed. Compiles out when disabled.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "cybsp.h"
+#include "boot_profile.h"
+#include <stdio.h>
+
+#if ENABLE_BOOT_PROFILE
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static const char *const boot_profile_names[BOOT_PHASE_COUNT] =
+{
+    "cybsp_init",
+    "retarget-io init",
+    "NVIC setup",
+    "timer start",
+    "POSIF start",
+    "first CHE",
+    "first speed"
+};
+
+/* SysTick periods since the time base was started */
+static volatile uint32_t boot_profile_ticks = 0U;
+
+/* Time of each phase in microseconds, 0 if not reached yet */
+static uint32_t boot_profile_time_us[BOOT_PHASE_COUNT];
+
+/* Set once the profile has been printed */
+static bool boot_profile_printed = false;
+
+/*******************************************************************************
+* Function Name: boot_profile_tick
+********************************************************************************
+* Summary:
+*  Extends the SysTick counter to a free-running time base. Must be called
+*  from the SysTick handler. The SysTick timer must be configured at the start
+*  of main() and not be reconfigured afterwards.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void boot_profile_tick(void)
+{
+    boot_profile_ticks++;
+}
+
+/*******************************************************************************
+* Function Name: boot_profile_get_us
+********************************************************************************
+* Summary:
+*  Returns the time since the SysTick timer was started. Can be called from
+*  interrupt handlers and with interrupts disabled, where a wrap of the
+*  counter is not counted yet by the SysTick handler.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t: time in microseconds
+*
+*******************************************************************************/
+static uint32_t boot_profile_get_us(void)
+{
+    uint32_t reload = SysTick->LOAD + 1U;
+    uint32_t count;
+    uint32_t ticks;
+    uint32_t value;
+
+    /* Read again if the SysTick handler ran between the reads */
+    do
+    {
+        count = boot_profile_ticks;
+        ticks = count;
+        value = SysTick->VAL;
+
+        /* A pending SysTick exception is a wrap that is not counted yet.
+         * The value is read again, as it may have been read before the wrap.
+         * Unlike COUNTFLAG, the pending bit is not cleared by reading it */
+        if ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0U)
+        {
+            value = SysTick->VAL;
+            ticks++;
+        }
+    } while (count != boot_profile_ticks);
+
+    return (ticks * ((reload * 1000U) / (SystemCoreClock / 1000U))) +
+           (((reload - value) * 1000U) / (SystemCoreClock / 1000U));
+}
+
+/*******************************************************************************
+* Function Name: boot_profile_mark
+********************************************************************************
+* Summary:
+*  Records the completion time of a startup phase. Only the first call for
+*  each phase is recorded, so it can be called on every event.
+*
+* Parameters:
+*  phase: completed startup phase
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void boot_profile_mark(boot_phase_t phase)
+{
+    if (boot_profile_time_us[phase] == 0U)
+    {
+        boot_profile_time_us[phase] = boot_profile_get_us();
+    }
+}
+
+/*******************************************************************************
+* Function Name: boot_profile_print
+********************************************************************************
+* Summary:
+*  Prints the time and duration of every startup phase once, after the last
+*  phase was recorded.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void boot_profile_print(void)
+{
+    uint32_t previous = 0U;
+    uint32_t i;
+
+    if (boot_profile_printed || (boot_profile_time_us[BOOT_PHASE_FIRST_SPEED] == 0U))
+    {
+        return;
+    }
+    boot_profile_printed = true;
+
+    printf("Boot profile (time since start of main / phase duration):\r\n");
+    for (i = 0U; i < BOOT_PHASE_COUNT; i++)
+    {
+        printf("  %-16s %8luus %8luus\r\n", boot_profile_names[i],
+                (unsigned long)boot_profile_time_us[i],
+                (unsigned long)(boot_profile_time_us[i] - previous));
+        previous = boot_profile_time_us[i];
+    }
+}
+
+#endif /* ENABLE_BOOT_PROFILE */
@@ -0,0 +1,77 @@
+/*******************************************************************************
+* File Name:   boot_profile.h
+*
+* Description: Boot time profiling: timestamps of the startup phases from reset
+*              to the first reported speed. Compiles out when disabled.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#ifndef BOOT_PROFILE_H_
+#define BOOT_PROFILE_H_
+
+#include <stdint.h>
+
+/*******************************************************************************
+* Data structure and enumeration
+*******************************************************************************/
+/* Startup phases, recorded when they complete */
+typedef enum
+{
+    BOOT_PHASE_CYBSP_INIT,      /* Device and board peripherals initialised */
+    BOOT_PHASE_RETARGET_IO,     /* Debug UART ready */
+    BOOT_PHASE_NVIC,            /* Interrupts configured */
+    BOOT_PHASE_TIMERS,          /* Hall simulation timers started */
+    BOOT_PHASE_POSIF_START,     /* POSIF and capture timers started */
+    BOOT_PHASE_FIRST_CHE,       /* First correct hall event */
+    BOOT_PHASE_FIRST_SPEED,     /* First speed printed */
+    BOOT_PHASE_COUNT
+} boot_phase_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+#if ENABLE_BOOT_PROFILE
+void boot_profile_tick(void);
+void boot_profile_mark(boot_phase_t phase);
+void boot_profile_print(void);
+
+#define BOOT_PROFILE_TICK()                 boot_profile_tick()
+#define BOOT_PROFILE_MARK(phase)            boot_profile_mark(phase)
+#define BOOT_PROFILE_PRINT()                boot_profile_print()
+#else
+#define BOOT_PROFILE_TICK()
+#define BOOT_PROFILE_MARK(phase)
+#define BOOT_PROFILE_PRINT()
+#endif
+
+#endif /* BOOT_PROFILE_H_ */
@@ -0,0 +1,276 @@
+/*******************************************************************************
+* File Name:   hall_angle.c
+*
+* Description: Electrical rotor angle interpolated from the hall sector and the
+*              elapsed speed timer ticks, and its sine for commutation.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "cybsp.h"
+#include "hall_angle.h"
+#include "hall_speed.h"
+#if ENABLE_MATH_COPROCESSOR && defined(MATH)
+#include "xmc_math.h"
+#endif
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Use the MATH coprocessor CORDIC when enabled and present on the device */
+#if ENABLE_MATH_COPROCESSOR && defined(MATH)
+#define HALL_ANGLE_USE_CORDIC               (1)
+#else
+#define HALL_ANGLE_USE_CORDIC               (0)
+#endif
+
+/* Angle covered by one hall sector */
+#define HALL_ANGLE_SECTOR                   ((uint32_t)(HALL_ANGLE_FULL_TURN / HALL_SECTORS_PER_PERIOD))
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* Start angle of the sector for each canonical hall code. The angle grows
+ * along the hall sequence, which is 1 -> 3 -> 2 -> 6 -> 4 -> 5 until another
+ * one is set with hall_angle_set_sequence(). Codes 0 and 7 are invalid */
+static uint16_t hall_angle_sector_start[8] =
+{
+    0U,
+    0U * HALL_ANGLE_SECTOR,     /* 1 */
+    2U * HALL_ANGLE_SECTOR,     /* 2 */
+    1U * HALL_ANGLE_SECTOR,     /* 3 */
+    4U * HALL_ANGLE_SECTOR,     /* 4 */
+    5U * HALL_ANGLE_SECTOR,     /* 5 */
+    3U * HALL_ANGLE_SECTOR,     /* 6 */
+    0U
+};
+
+/* Quarter wave sine table in Q15, 64 steps from 0 to 90 degrees */
+static const int16_t hall_angle_sin_lut[65] =
+{
+        0,   804,  1608,  2410,  3212,  4011,  4808,  5602,
+     6393,  7179,  7962,  8739,  9512, 10278, 11039, 11793,
+    12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530,
+    18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594,
+    23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790,
+    27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+    30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971,
+    32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757,
+    32767
+};
+
+#if !HALL_ANGLE_USE_CORDIC
+/* Sine of the angle passed to hall_angle_start_sin() */
+static int16_t hall_angle_pending_sin = 0;
+#endif
+
+/*******************************************************************************
+* Function Name: hall_angle_set_sequence
+********************************************************************************
+* Summary:
+*  Sets the hall sequence the sector start angles are taken from, so that the
+*  angle also grows steadily when the motor turns in reverse. The first code
+*  of the sequence starts at 0 degrees.
+*
+* Parameters:
+*  sequence: the HALL_SECTORS_PER_PERIOD canonical hall codes in the order
+*            of rotation
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_angle_set_sequence(const uint8_t *sequence)
+{
+    uint32_t i;
+
+    for (i = 0U; i < 8U; i++)
+    {
+        hall_angle_sector_start[i] = 0U;
+    }
+
+    for (i = 0U; i < HALL_SECTORS_PER_PERIOD; i++)
+    {
+        hall_angle_sector_start[sequence[i] & 0x07U] = (uint16_t)(i * HALL_ANGLE_SECTOR);
+    }
+}
+
+/*******************************************************************************
+* Function Name: hall_angle_get
+********************************************************************************
+* Summary:
+*  Interpolates the electrical angle inside the current hall sector, assuming
+*  the current sector lasts as long as the previous one. The interpolation
+*  stops at the end of the sector until the next correct hall event.
+*
+* Parameters:
+*  hall_position: hall input pattern (HALL_INPUT_3 << 2 | ... | HALL_INPUT_1)
+*  elapsed_ticks: speed timer ticks since the last correct hall event
+*  sector_ticks: speed timer ticks of the previous hall sector
+*
+* Return:
+*  uint16_t: electrical angle, 0x10000 corresponds to 360 degrees
+*
+*******************************************************************************/
+uint16_t hall_angle_get(uint8_t hall_position, uint32_t elapsed_ticks, uint32_t sector_ticks)
+{
+    uint32_t angle = hall_angle_sector_start[hall_position & 0x07U];
+
+    if (sector_ticks != 0U)
+    {
+        if (elapsed_ticks >= sector_ticks)
+        {
+            elapsed_ticks = sector_ticks - 1U;
+        }
+        /* Speed timer values are 16 bit, so the product fits into 32 bit */
+        angle += hall_speed_udiv(elapsed_ticks * HALL_ANGLE_SECTOR, sector_ticks);
+    }
+
+    return (uint16_t)angle;
+}
+
+/*******************************************************************************
+* Function Name: hall_angle_start_sin
+********************************************************************************
+* Summary:
+*  Starts the sine calculation of an electrical angle. With the MATH
+*  coprocessor backend the CORDIC runs in the background until
+*  hall_angle_read_sin() is called; otherwise the result is computed
+*  immediately from the sine table.
+*
+* Parameters:
+*  angle: electrical angle, 0x10000 corresponds to 360 degrees
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_angle_start_sin(uint16_t angle)
+{
+#if HALL_ANGLE_USE_CORDIC
+    /* CORDIC input is Q0.23 normalised to pi in the range [-pi, pi) */
+    XMC_MATH_CORDIC_SinNB((XMC_MATH_Q0_23_t)((int32_t)(int16_t)angle * 256));
+#else
+    hall_angle_pending_sin = hall_angle_sin(angle);
+#endif
+}
+
+/*******************************************************************************
+* Function Name: hall_angle_read_sin
+********************************************************************************
+* Summary:
+*  Returns the sine started with hall_angle_start_sin().
+*
+* Parameters:
+*  none
+*
+* Return:
+*  int16_t: sine in Q15
+*
+*******************************************************************************/
+int16_t hall_angle_read_sin(void)
+{
+#if HALL_ANGLE_USE_CORDIC
+    int32_t result = XMC_MATH_CORDIC_GetSinResult() / 256;
+
+    /* Saturate +1.0 to the largest Q15 value */
+    return (int16_t)((result > INT16_MAX) ? INT16_MAX : result);
+#else
+    return hall_angle_pending_sin;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: hall_angle_sin_table
+********************************************************************************
+* Summary:
+*  Calculates the sine of an electrical angle from a quarter wave table with
+*  linear interpolation, also when the CORDIC backend is selected.
+*
+* Parameters:
+*  angle: electrical angle, 0x10000 corresponds to 360 degrees
+*
+* Return:
+*  int16_t: sine in Q15
+*
+*******************************************************************************/
+int16_t hall_angle_sin_table(uint16_t angle)
+{
+    uint32_t quarter = (uint32_t)angle >> 14;
+    uint32_t offset = (uint32_t)angle & 0x3FFFU;
+    uint32_t index;
+    int32_t value;
+
+    /* Mirror the second and fourth quarter */
+    if ((quarter & 1U) != 0U)
+    {
+        offset = 0x4000U - offset;
+    }
+
+    index = offset >> 8;
+    if (index >= 64U)
+    {
+        value = hall_angle_sin_lut[64];
+    }
+    else
+    {
+        value = hall_angle_sin_lut[index] +
+                (((hall_angle_sin_lut[index + 1U] - hall_angle_sin_lut[index]) *
+                  (int32_t)(offset & 0xFFU)) >> 8);
+    }
+
+    return (int16_t)((quarter >= 2U) ? -value : value);
+}
+
+/*******************************************************************************
+* Function Name: hall_angle_sin
+********************************************************************************
+* Summary:
+*  Calculates the sine of an electrical angle, using the MATH coprocessor
+*  CORDIC when enabled or hall_angle_sin_table().
+*
+* Parameters:
+*  angle: electrical angle, 0x10000 corresponds to 360 degrees
+*
+* Return:
+*  int16_t: sine in Q15
+*
+*******************************************************************************/
+int16_t hall_angle_sin(uint16_t angle)
+{
+#if HALL_ANGLE_USE_CORDIC
+    hall_angle_start_sin(angle);
+    return hall_angle_read_sin();
+#else
+    return hall_angle_sin_table(angle);
+#endif
+}
@@ -0,0 +1,60 @@
+/*******************************************************************************
+* File Name:   hall_angle.h
+*
+* Description: Electrical rotor angle interpolated from the hall sector and the
+*              elapsed speed timer ticks, and its sine for commutation.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#ifndef HALL_ANGLE_H_
+#define HALL_ANGLE_H_
+
+#include <stdint.h>
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Full electrical revolution in angle units (uint16_t wraps at 360 degrees) */
+#define HALL_ANGLE_FULL_TURN                (0x10000UL)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void hall_angle_set_sequence(const uint8_t *sequence);
+uint16_t hall_angle_get(uint8_t hall_position, uint32_t elapsed_ticks, uint32_t sector_ticks);
+int16_t hall_angle_sin(uint16_t angle);
+int16_t hall_angle_sin_table(uint16_t angle);
+void hall_angle_start_sin(uint16_t angle);
+int16_t hall_angle_read_sin(void);
+
+#endif /* HALL_ANGLE_H_ */
@@ -0,0 +1,271 @@
+/*******************************************************************************
+* File Name:   hall_detect.c
+*
+* Description: Automatic detection of the hall sequence and direction from the
+*              observed hall input transitions, used to program the POSIF hall
+*              patterns independently of the sensor wiring order.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "hall_detect.h"
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Marks an unknown hall position or successor */
+#define HALL_DETECT_NONE                    (0U)
+
+/* Number of valid hall positions (1 to 6) */
+#define HALL_DETECT_NUM_POSITIONS           (6U)
+
+/* Position field of a POSIF hall pattern: current in bits 0-2, expected in 3-5 */
+#define HALL_DETECT_EXPECTED_SHIFT          (3U)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* Successor in forward direction (1 -> 3 -> 2 -> 6 -> 4 -> 5) */
+static const uint8_t hall_detect_forward[8] = { 0U, 3U, 6U, 2U, 5U, 1U, 4U, 0U };
+
+/* Observed successor of every hall position */
+static uint8_t hall_detect_next[8];
+
+/* Last sampled position and number of consistent transitions */
+static uint8_t hall_detect_last = HALL_DETECT_NONE;
+static uint32_t hall_detect_transitions = 0U;
+
+static hall_detect_direction_t hall_detect_direction = HALL_DETECT_FORWARD;
+
+/*******************************************************************************
+* Function Name: hall_detect_reset
+********************************************************************************
+* Summary:
+*  Discards all observations and starts a new detection.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_detect_reset(void)
+{
+    uint32_t i;
+
+    for (i = 0U; i < 8U; i++)
+    {
+        hall_detect_next[i] = HALL_DETECT_NONE;
+    }
+    hall_detect_last = HALL_DETECT_NONE;
+    hall_detect_transitions = 0U;
+}
+
+/*******************************************************************************
+* Function Name: hall_detect_is_cycle
+********************************************************************************
+* Summary:
+*  Checks that the observed successors form one cycle through all six valid
+*  hall positions.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  bool: true if the successors form a single six step cycle
+*
+*******************************************************************************/
+static bool hall_detect_is_cycle(void)
+{
+    uint8_t position = 1U;
+    uint32_t i;
+
+    for (i = 0U; i < HALL_DETECT_NUM_POSITIONS; i++)
+    {
+        position = hall_detect_next[position];
+        if (position == HALL_DETECT_NONE)
+        {
+            return false;
+        }
+        if ((position == 1U) && (i != (HALL_DETECT_NUM_POSITIONS - 1U)))
+        {
+            return false;
+        }
+    }
+
+    return (position == 1U);
+}
+
+/*******************************************************************************
+* Function Name: hall_detect_sample
+********************************************************************************
+* Summary:
+*  Feeds one sample of the hall inputs. Samples must be taken often enough
+*  that no transition is missed. A transition is rejected, and the detection
+*  restarted, if it
+*   - involves the invalid positions 0 or 7,
+*   - changes more than one hall input, or
+*   - contradicts an earlier transition from the same position.
+*  The sequence is accepted after HALL_DETECT_TRANSITIONS consistent
+*  transitions that form one cycle through all six positions.
+*
+* Parameters:
+*  hall_position: hall input pattern (HALL_INPUT_3 << 2 | ... | HALL_INPUT_1)
+*
+* Return:
+*  hall_detect_status_t: detection status
+*
+*******************************************************************************/
+hall_detect_status_t hall_detect_sample(uint8_t hall_position)
+{
+    uint8_t changed;
+
+    hall_position &= 0x07U;
+
+    if ((hall_position == 0U) || (hall_position == 7U))
+    {
+        hall_detect_reset();
+        return HALL_DETECT_REJECTED;
+    }
+
+    if (hall_detect_last == HALL_DETECT_NONE)
+    {
+        hall_detect_last = hall_position;
+        return HALL_DETECT_BUSY;
+    }
+    if (hall_position == hall_detect_last)
+    {
+        return (hall_detect_transitions >= HALL_DETECT_TRANSITIONS) ? HALL_DETECT_DONE : HALL_DETECT_BUSY;
+    }
+
+    /* Exactly one input may change per transition */
+    changed = hall_position ^ hall_detect_last;
+    if ((changed & (changed - 1U)) != 0U)
+    {
+        hall_detect_reset();
+        return HALL_DETECT_REJECTED;
+    }
+
+    if (hall_detect_next[hall_detect_last] == HALL_DETECT_NONE)
+    {
+        hall_detect_next[hall_detect_last] = hall_position;
+    }
+    else if (hall_detect_next[hall_detect_last] != hall_position)
+    {
+        /* Direction change or missed transition */
+        hall_detect_reset();
+        return HALL_DETECT_REJECTED;
+    }
+    hall_detect_last = hall_position;
+    hall_detect_transitions++;
+
+    if ((hall_detect_transitions < HALL_DETECT_TRANSITIONS) || !hall_detect_is_cycle())
+    {
+        return HALL_DETECT_BUSY;
+    }
+
+    hall_detect_direction = (hall_detect_next[1] == hall_detect_forward[1]) ?
+            HALL_DETECT_FORWARD : HALL_DETECT_REVERSE;
+
+    return HALL_DETECT_DONE;
+}
+
+/*******************************************************************************
+* Function Name: hall_detect_get_direction
+********************************************************************************
+* Summary:
+*  Returns the detected direction of rotation. Any wiring order of the three
+*  hall inputs produces either the forward or the reverse sequence.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  hall_detect_direction_t: direction relative to 1 -> 3 -> 2 -> 6 -> 4 -> 5
+*
+*******************************************************************************/
+hall_detect_direction_t hall_detect_get_direction(void)
+{
+    return hall_detect_direction;
+}
+
+/*******************************************************************************
+* Function Name: hall_detect_get_patterns
+********************************************************************************
+* Summary:
+*  Builds the POSIF hall pattern table for the detected sequence. The entry of
+*  each hall position holds the position as current pattern and its observed
+*  successor as expected pattern, the format used by
+*  XMC_POSIF_HSC_SetHallPatterns().
+*
+* Parameters:
+*  patterns: destination, 8 entries indexed by hall position
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_detect_get_patterns(uint8_t *patterns)
+{
+    uint32_t i;
+
+    for (i = 0U; i < 8U; i++)
+    {
+        patterns[i] = (uint8_t)(i | ((uint32_t)hall_detect_next[i] << HALL_DETECT_EXPECTED_SHIFT));
+    }
+}
+
+/*******************************************************************************
+* Function Name: hall_detect_get_sequence
+********************************************************************************
+* Summary:
+*  Returns the detected sequence starting at hall position 1.
+*
+* Parameters:
+*  sequence: destination, 6 entries
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_detect_get_sequence(uint8_t *sequence)
+{
+    uint8_t position = 1U;
+    uint32_t i;
+
+    for (i = 0U; i < HALL_DETECT_NUM_POSITIONS; i++)
+    {
+        sequence[i] = position;
+        position = hall_detect_next[position];
+    }
+}
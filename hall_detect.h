@@ -0,0 +1,79 @@
+/*******************************************************************************
+* File Name:   hall_detect.h
+*
+* Description: Automatic detection of the hall sequence and direction from the
+*              observed hall input transitions, used to program the POSIF hall
+*              patterns independently of the sensor wiring order.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#ifndef HALL_DETECT_H_
+#define HALL_DETECT_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Consistent transitions required before the sequence is accepted */
+#ifndef HALL_DETECT_TRANSITIONS
+#define HALL_DETECT_TRANSITIONS             (12U)
+#endif
+
+/*******************************************************************************
+* Data structure and enumeration
+*******************************************************************************/
+typedef enum
+{
+    HALL_DETECT_BUSY,       /* Still observing */
+    HALL_DETECT_DONE,       /* Sequence detected */
+    HALL_DETECT_REJECTED    /* Inconsistent observation, restarted */
+} hall_detect_status_t;
+
+typedef enum
+{
+    HALL_DETECT_FORWARD,    /* Sequence 1 -> 3 -> 2 -> 6 -> 4 -> 5 */
+    HALL_DETECT_REVERSE     /* Sequence 1 -> 5 -> 4 -> 6 -> 2 -> 3 */
+} hall_detect_direction_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void hall_detect_reset(void);
+hall_detect_status_t hall_detect_sample(uint8_t hall_position);
+hall_detect_direction_t hall_detect_get_direction(void);
+void hall_detect_get_patterns(uint8_t *patterns);
+void hall_detect_get_sequence(uint8_t *sequence);
+
+#endif /* HALL_DETECT_H_ */
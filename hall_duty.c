@@ -0,0 +1,231 @@
+/*******************************************************************************
+* File Name:   hall_duty.c
+*
+* Description: Per-sensor duty cycle monitoring derived from the sector times and
+*              hall patterns, with drift alarms for sensor health.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "cybsp.h"
+#include "hall_duty.h"
+#include "hall_speed.h"
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Marks that no pattern was seen since the last restart */
+#define HALL_DUTY_NO_PATTERN                (0xFFU)
+
+/* Average is kept with 8 fractional bits */
+#define HALL_DUTY_AVERAGE_FRAC_BITS         (8U)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* Pattern of the sector that is currently running */
+static uint8_t hall_duty_pattern = HALL_DUTY_NO_PATTERN;
+
+/* High and total time of each sensor in the current electrical period */
+static uint32_t hall_duty_high[HALL_DUTY_NUM_SENSORS];
+static uint32_t hall_duty_total = 0U;
+static uint32_t hall_duty_sectors = 0U;
+
+/* Averaged duty cycle in permille with fractional bits */
+static uint32_t hall_duty_average[HALL_DUTY_NUM_SENSORS];
+
+static hall_duty_stats_t hall_duty_stats[HALL_DUTY_NUM_SENSORS];
+
+/* Number of complete electrical periods */
+static uint32_t hall_duty_periods = 0U;
+
+/*******************************************************************************
+* Function Name: hall_duty_restart_period
+********************************************************************************
+* Summary:
+*  Discards the electrical period being measured. Used after a wrong hall
+*  event, when the sector times no longer belong to known patterns. May be
+*  called from the SysTick handler, so the hall events are held off.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_duty_restart_period(void)
+{
+    uint32_t i;
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    for (i = 0U; i < HALL_DUTY_NUM_SENSORS; i++)
+    {
+        hall_duty_high[i] = 0U;
+    }
+    hall_duty_total = 0U;
+    hall_duty_sectors = 0U;
+    hall_duty_pattern = HALL_DUTY_NO_PATTERN;
+    __set_PRIMASK(primask);
+}
+
+/*******************************************************************************
+* Function Name: hall_duty_reset
+********************************************************************************
+* Summary:
+*  Clears all statistics and alarms.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_duty_reset(void)
+{
+    uint32_t i;
+
+    hall_duty_restart_period();
+    for (i = 0U; i < HALL_DUTY_NUM_SENSORS; i++)
+    {
+        hall_duty_average[i] = 500UL << HALL_DUTY_AVERAGE_FRAC_BITS;
+        hall_duty_stats[i].last = 500U;
+        hall_duty_stats[i].average = 500U;
+        hall_duty_stats[i].min = 1000U;
+        hall_duty_stats[i].max = 0U;
+        hall_duty_stats[i].alarm = false;
+    }
+    hall_duty_periods = 0U;
+}
+
+/*******************************************************************************
+* Function Name: hall_duty_update
+********************************************************************************
+* Summary:
+*  Called on every correct hall event with the new hall pattern and the time
+*  of the sector that just ended. The ended sector time is credited to the
+*  high time of every sensor that was high during it. After six sectors the
+*  duty cycle of each sensor is evaluated. Constant time per event.
+*
+* Parameters:
+*  hall_pattern: hall pattern after the event (HALL_INPUT_3 << 2 | ... | HALL_INPUT_1)
+*  sector_ticks: captured speed timer value of the sector that just ended
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_duty_update(uint8_t hall_pattern, uint32_t sector_ticks)
+{
+    uint32_t duty;
+    uint32_t i;
+
+    if (hall_duty_pattern != HALL_DUTY_NO_PATTERN)
+    {
+        for (i = 0U; i < HALL_DUTY_NUM_SENSORS; i++)
+        {
+            if ((hall_duty_pattern & (1U << i)) != 0U)
+            {
+                hall_duty_high[i] += sector_ticks;
+            }
+        }
+        hall_duty_total += sector_ticks;
+        hall_duty_sectors++;
+    }
+    hall_duty_pattern = hall_pattern & 0x07U;
+
+    if ((hall_duty_sectors < HALL_SECTORS_PER_PERIOD) || (hall_duty_total == 0U))
+    {
+        return;
+    }
+
+    for (i = 0U; i < HALL_DUTY_NUM_SENSORS; i++)
+    {
+        duty = hall_speed_udiv(hall_duty_high[i] * 1000U, hall_duty_total);
+
+        /* average += (duty - average) * 2^-SHIFT */
+        hall_duty_average[i] = hall_duty_average[i] -
+                (hall_duty_average[i] >> HALL_DUTY_AVERAGE_SHIFT) +
+                ((duty << HALL_DUTY_AVERAGE_FRAC_BITS) >> HALL_DUTY_AVERAGE_SHIFT);
+
+        hall_duty_stats[i].last = (uint16_t)duty;
+        hall_duty_stats[i].average = (uint16_t)(hall_duty_average[i] >> HALL_DUTY_AVERAGE_FRAC_BITS);
+        if (duty < hall_duty_stats[i].min)
+        {
+            hall_duty_stats[i].min = (uint16_t)duty;
+        }
+        if (duty > hall_duty_stats[i].max)
+        {
+            hall_duty_stats[i].max = (uint16_t)duty;
+        }
+        hall_duty_stats[i].alarm =
+                (hall_duty_stats[i].average > (500U + HALL_DUTY_ALARM_PERMILLE)) ||
+                (hall_duty_stats[i].average < (500U - HALL_DUTY_ALARM_PERMILLE));
+
+        hall_duty_high[i] = 0U;
+    }
+    hall_duty_total = 0U;
+    hall_duty_sectors = 0U;
+    hall_duty_periods++;
+}
+
+/*******************************************************************************
+* Function Name: hall_duty_get_stats
+********************************************************************************
+* Summary:
+*  Copies the statistics of all sensors.
+*
+* Parameters:
+*  stats: destination, HALL_DUTY_NUM_SENSORS entries
+*
+* Return:
+*  uint32_t: number of evaluated electrical periods
+*
+*******************************************************************************/
+uint32_t hall_duty_get_stats(hall_duty_stats_t *stats)
+{
+    uint32_t primask = __get_PRIMASK();
+    uint32_t periods;
+    uint32_t i;
+
+    __disable_irq();
+    for (i = 0U; i < HALL_DUTY_NUM_SENSORS; i++)
+    {
+        stats[i] = hall_duty_stats[i];
+    }
+    periods = hall_duty_periods;
+    __set_PRIMASK(primask);
+
+    return periods;
+}
@@ -0,0 +1,82 @@
+/*******************************************************************************
+* File Name:   hall_duty.h
+*
+* Description: Per-sensor duty cycle monitoring derived from the sector times and
+*              hall patterns, with drift alarms for sensor health.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#ifndef HALL_DUTY_H_
+#define HALL_DUTY_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Number of hall sensors */
+#define HALL_DUTY_NUM_SENSORS               (3U)
+
+/* Allowed deviation of the averaged duty cycle from 500 permille */
+#ifndef HALL_DUTY_ALARM_PERMILLE
+#define HALL_DUTY_ALARM_PERMILLE            (30U)
+#endif
+
+/* Averaging of the duty cycle over electrical periods: weight 2^-SHIFT */
+#ifndef HALL_DUTY_AVERAGE_SHIFT
+#define HALL_DUTY_AVERAGE_SHIFT             (4U)
+#endif
+
+/*******************************************************************************
+* Data structure and enumeration
+*******************************************************************************/
+/* Duty cycle statistics of one sensor, all in permille */
+typedef struct
+{
+    uint16_t last;      /* Duty cycle of the last electrical period */
+    uint16_t average;   /* Exponentially weighted average */
+    uint16_t min;       /* Minimum since the last reset */
+    uint16_t max;       /* Maximum since the last reset */
+    bool alarm;         /* Average outside 500 +/- HALL_DUTY_ALARM_PERMILLE */
+} hall_duty_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void hall_duty_reset(void);
+void hall_duty_restart_period(void);
+void hall_duty_update(uint8_t hall_pattern, uint32_t sector_ticks);
+uint32_t hall_duty_get_stats(hall_duty_stats_t *stats);
+
+#endif /* HALL_DUTY_H_ */
@@ -0,0 +1,144 @@
+/*******************************************************************************
+* File Name:   hall_edge_buffer.c
+*
+* Description: Ring buffer of the speed timer values captured on correct hall
+*              events. Filled by the CHE interrupt and drained in blocks by the
+*              main loop.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "hall_edge_buffer.h"
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+#define HALL_EDGE_BUFFER_MASK               (HALL_EDGE_BUFFER_SIZE - 1U)
+
+#if (HALL_EDGE_BUFFER_SIZE & HALL_EDGE_BUFFER_MASK) != 0U
+#error "HALL_EDGE_BUFFER_SIZE must be a power of two"
+#endif
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* Sector times, written only by the interrupt and read only by the main loop.
+ * The free running indices are wrapped with the mask on access */
+static uint32_t hall_edge_buffer_data[HALL_EDGE_BUFFER_SIZE];
+static volatile uint32_t hall_edge_buffer_head = 0U;
+static volatile uint32_t hall_edge_buffer_tail = 0U;
+
+/* Number of sector times dropped because the buffer was full */
+static volatile uint32_t hall_edge_buffer_overflows = 0U;
+
+/*******************************************************************************
+* Function Name: hall_edge_buffer_push
+********************************************************************************
+* Summary:
+*  Adds one sector time to the buffer. Must only be called from the CHE
+*  interrupt.
+*
+* Parameters:
+*  sector_ticks: captured speed timer value of one hall sector
+*
+* Return:
+*  bool: false if the buffer was full and the value was dropped
+*
+*******************************************************************************/
+bool hall_edge_buffer_push(uint32_t sector_ticks)
+{
+    uint32_t head = hall_edge_buffer_head;
+
+    if ((head - hall_edge_buffer_tail) >= HALL_EDGE_BUFFER_SIZE)
+    {
+        hall_edge_buffer_overflows++;
+        return false;
+    }
+
+    hall_edge_buffer_data[head & HALL_EDGE_BUFFER_MASK] = sector_ticks;
+    hall_edge_buffer_head = head + 1U;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: hall_edge_buffer_read
+********************************************************************************
+* Summary:
+*  Copies the oldest buffered sector times and removes them from the buffer.
+*  Must only be called from the main loop.
+*
+* Parameters:
+*  sector_ticks: destination of the sector times
+*  max_count: size of the destination
+*
+* Return:
+*  uint32_t: number of sector times copied
+*
+*******************************************************************************/
+uint32_t hall_edge_buffer_read(uint32_t *sector_ticks, uint32_t max_count)
+{
+    uint32_t tail = hall_edge_buffer_tail;
+    uint32_t count = hall_edge_buffer_head - tail;
+    uint32_t i;
+
+    if (count > max_count)
+    {
+        count = max_count;
+    }
+
+    for (i = 0U; i < count; i++)
+    {
+        sector_ticks[i] = hall_edge_buffer_data[(tail + i) & HALL_EDGE_BUFFER_MASK];
+    }
+    hall_edge_buffer_tail = tail + count;
+
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: hall_edge_buffer_get_overflows
+********************************************************************************
+* Summary:
+*  Returns the number of sector times dropped because the buffer was full.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t: overflow count
+*
+*******************************************************************************/
+uint32_t hall_edge_buffer_get_overflows(void)
+{
+    return hall_edge_buffer_overflows;
+}
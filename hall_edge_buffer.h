@@ -0,0 +1,61 @@
+/*******************************************************************************
+* File Name:   hall_edge_buffer.h
+*
+* Description: Ring buffer of the speed timer values captured on correct hall
+*              events. Filled by the CHE interrupt and drained in blocks by the
+*              main loop.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#ifndef HALL_EDGE_BUFFER_H_
+#define HALL_EDGE_BUFFER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Number of buffered hall sector times, must be a power of two */
+#ifndef HALL_EDGE_BUFFER_SIZE
+#define HALL_EDGE_BUFFER_SIZE               (32U)
+#endif
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool hall_edge_buffer_push(uint32_t sector_ticks);
+uint32_t hall_edge_buffer_read(uint32_t *sector_ticks, uint32_t max_count);
+uint32_t hall_edge_buffer_get_overflows(void);
+
+#endif /* HALL_EDGE_BUFFER_H_ */
@@ -0,0 +1,222 @@
+/*******************************************************************************
+* File Name:   hall_filter.c
+*
+* Description: Low-pass filtering and decimation of the hall sector times in
+*              blocks. XMC4000 devices use the CMSIS-DSP Q31 biquad kernel,
+*              other devices a C implementation with identical arithmetic.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "cybsp.h"
+#include "hall_filter.h"
+
+#if ENABLE_CMSIS_DSP_FILTER
+
+#if (UC_FAMILY == XMC4)
+#include "arm_math.h"
+#endif
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Sector times are at most 16 bit; one bit of headroom is kept for the
+ * overshoot of the filter step response */
+#define HALL_FILTER_INPUT_SHIFT             (14U)
+
+/* Coefficients are scaled by 2^-HALL_FILTER_POST_SHIFT to fit into Q31 */
+#define HALL_FILTER_POST_SHIFT              (1U)
+
+/* Number of biquad coefficients per stage */
+#define HALL_FILTER_NUM_COEFFS              (5U)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* Second order Butterworth low-pass, cut-off at 0.1 of the hall event rate,
+ * which is also below the Nyquist frequency after decimation by 4.
+ * Order {b0, b1, b2, a1, a2} with y = b0*x0 + b1*x1 + b2*x2 + a1*y1 + a2*y2 */
+static const int32_t hall_filter_coeffs[HALL_FILTER_NUM_COEFFS] =
+{
+    72429549, 144859098, 72429549, 1227265970, -443242341
+};
+
+/* Filter state {x1, x2, y1, y2} */
+static int32_t hall_filter_state[HALL_FILTER_NUM_STATES];
+
+/* Filtered sector times to skip before the next decimated output */
+static uint32_t hall_filter_phase;
+
+#if (UC_FAMILY == XMC4)
+static arm_biquad_casd_df1_inst_q31 hall_filter_instance;
+#endif
+
+/*******************************************************************************
+* Function Name: hall_filter_init
+********************************************************************************
+* Summary:
+*  Resets the filter state and the decimation phase.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_filter_init(void)
+{
+    uint32_t i;
+
+    for (i = 0U; i < HALL_FILTER_NUM_STATES; i++)
+    {
+        hall_filter_state[i] = 0;
+    }
+    hall_filter_phase = HALL_FILTER_DECIMATION - 1U;
+
+#if (UC_FAMILY == XMC4)
+    arm_biquad_cascade_df1_init_q31(&hall_filter_instance, 1U, (q31_t *)hall_filter_coeffs,
+                                    hall_filter_state, (int8_t)HALL_FILTER_POST_SHIFT);
+#endif
+}
+
+/*******************************************************************************
+* Function Name: hall_filter_biquad_c
+********************************************************************************
+* Summary:
+*  Low-pass filters a block of Q31 samples in place with the C implementation.
+*  It follows the arithmetic of arm_biquad_cascade_df1_q31() (64-bit
+*  accumulation, truncating shift), so all devices produce the same output
+*  for the same input.
+*
+* Parameters:
+*  block: samples to filter, replaced by the filtered samples
+*  count: number of samples
+*  state: filter state {x1, x2, y1, y2}, HALL_FILTER_NUM_STATES values
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_filter_biquad_c(int32_t *block, uint32_t count, int32_t *state)
+{
+    int32_t x1 = state[0];
+    int32_t x2 = state[1];
+    int32_t y1 = state[2];
+    int32_t y2 = state[3];
+    int64_t acc;
+    uint32_t i;
+
+    for (i = 0U; i < count; i++)
+    {
+        acc = (int64_t)hall_filter_coeffs[0] * block[i];
+        acc += (int64_t)hall_filter_coeffs[1] * x1;
+        acc += (int64_t)hall_filter_coeffs[2] * x2;
+        acc += (int64_t)hall_filter_coeffs[3] * y1;
+        acc += (int64_t)hall_filter_coeffs[4] * y2;
+
+        x2 = x1;
+        x1 = block[i];
+        y2 = y1;
+        y1 = (int32_t)(acc >> (31U - HALL_FILTER_POST_SHIFT));
+        block[i] = y1;
+    }
+
+    state[0] = x1;
+    state[1] = x2;
+    state[2] = y1;
+    state[3] = y2;
+}
+
+/*******************************************************************************
+* Function Name: hall_filter_process
+********************************************************************************
+* Summary:
+*  Low-pass filters a block of sector times and keeps every
+*  HALL_FILTER_DECIMATION-th filtered value. The decimation phase continues
+*  across blocks, so the output does not depend on how the sector times are
+*  split into blocks.
+*
+* Parameters:
+*  sector_ticks: captured sector times
+*  filtered_ticks: destination of the decimated filtered sector times, may be
+*                  the same as sector_ticks
+*  count: number of sector times, at most HALL_FILTER_BLOCK_SIZE
+*
+* Return:
+*  uint32_t: number of decimated sector times written to filtered_ticks
+*
+*******************************************************************************/
+uint32_t hall_filter_process(const uint32_t *sector_ticks, uint32_t *filtered_ticks, uint32_t count)
+{
+    int32_t block[HALL_FILTER_BLOCK_SIZE];
+    uint32_t decimated = 0U;
+    uint32_t i;
+
+    if (count == 0U)
+    {
+        return 0U;
+    }
+    if (count > HALL_FILTER_BLOCK_SIZE)
+    {
+        count = HALL_FILTER_BLOCK_SIZE;
+    }
+
+    for (i = 0U; i < count; i++)
+    {
+        block[i] = (int32_t)(sector_ticks[i] << HALL_FILTER_INPUT_SHIFT);
+    }
+
+#if (UC_FAMILY == XMC4)
+    arm_biquad_cascade_df1_q31(&hall_filter_instance, block, block, count);
+#else
+    hall_filter_biquad_c(block, count, hall_filter_state);
+#endif
+
+    for (i = 0U; i < count; i++)
+    {
+        if (hall_filter_phase != 0U)
+        {
+            hall_filter_phase--;
+        }
+        else
+        {
+            hall_filter_phase = HALL_FILTER_DECIMATION - 1U;
+            filtered_ticks[decimated] = (block[i] > 0) ? ((uint32_t)block[i] >> HALL_FILTER_INPUT_SHIFT) : 0U;
+            decimated++;
+        }
+    }
+
+    return decimated;
+}
+
+#endif /* ENABLE_CMSIS_DSP_FILTER */
@@ -0,0 +1,66 @@
+/*******************************************************************************
+* File Name:   hall_filter.h
+*
+* Description: Low-pass filtering and decimation of the hall sector times in
+*              blocks. XMC4000 devices use the CMSIS-DSP Q31 biquad kernel,
+*              other devices a C implementation with identical arithmetic.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#ifndef HALL_FILTER_H_
+#define HALL_FILTER_H_
+
+#include <stdint.h>
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Maximum number of sector times filtered in one block */
+#define HALL_FILTER_BLOCK_SIZE              (16U)
+
+/* Number of filter state values {x1, x2, y1, y2} */
+#define HALL_FILTER_NUM_STATES              (4U)
+
+/* One filtered sector time is kept out of HALL_FILTER_DECIMATION */
+#ifndef HALL_FILTER_DECIMATION
+#define HALL_FILTER_DECIMATION              (4U)
+#endif
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void hall_filter_init(void);
+void hall_filter_biquad_c(int32_t *block, uint32_t count, int32_t *state);
+uint32_t hall_filter_process(const uint32_t *sector_ticks, uint32_t *filtered_ticks, uint32_t count);
+
+#endif /* HALL_FILTER_H_ */
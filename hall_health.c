@@ -0,0 +1,334 @@
+/*******************************************************************************
+* File Name:   hall_health.c
+*
+* Description: Health monitoring of the hall sensor signals from event counts over
+*              sliding windows.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "cybsp.h"
+#include "hall_health.h"
+#include "hall_speed.h"
+#include <stddef.h>
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Bucket count of each window and its bucket length in ticks of the next
+ * finer window. The finest window is advanced every HALL_HEALTH_TICK_MS */
+#define HALL_HEALTH_TICK_MS                 (100U)
+#define HALL_HEALTH_1S_BUCKETS              (10U)
+#define HALL_HEALTH_1MIN_BUCKETS            (12U)
+#define HALL_HEALTH_1MIN_BUCKET_TICKS       (50U)
+#define HALL_HEALTH_1H_BUCKETS              (60U)
+#define HALL_HEALTH_1H_BUCKET_TICKS         (12U)
+
+/*******************************************************************************
+* Data structure and enumeration
+*******************************************************************************/
+/* Ring of event count buckets with the running sum over all buckets */
+typedef struct
+{
+    uint32_t (*buckets)[HALL_HEALTH_NUM_EVENTS];
+    uint32_t num_buckets;
+    uint32_t bucket_ticks;      /* Finer window buckets per bucket */
+    uint32_t index;             /* Current bucket */
+    uint32_t ticks;             /* Finer window buckets added to the current one */
+    uint32_t sum[HALL_HEALTH_NUM_EVENTS];
+} hall_health_ring_t;
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static uint32_t hall_health_1s[HALL_HEALTH_1S_BUCKETS][HALL_HEALTH_NUM_EVENTS];
+static uint32_t hall_health_1min[HALL_HEALTH_1MIN_BUCKETS][HALL_HEALTH_NUM_EVENTS];
+static uint32_t hall_health_1h[HALL_HEALTH_1H_BUCKETS][HALL_HEALTH_NUM_EVENTS];
+
+static hall_health_ring_t hall_health_rings[HALL_HEALTH_NUM_WINDOWS] =
+{
+    { hall_health_1s,   HALL_HEALTH_1S_BUCKETS,   1U,                            0U, 0U, { 0U } },
+    { hall_health_1min, HALL_HEALTH_1MIN_BUCKETS, HALL_HEALTH_1MIN_BUCKET_TICKS, 0U, 0U, { 0U } },
+    { hall_health_1h,   HALL_HEALTH_1H_BUCKETS,   HALL_HEALTH_1H_BUCKET_TICKS,   0U, 0U, { 0U } }
+};
+
+/* Milliseconds into the current HALL_HEALTH_TICK_MS period */
+static uint32_t hall_health_ms = 0U;
+
+/*******************************************************************************
+* Function Name: hall_health_add
+********************************************************************************
+* Summary:
+*  Adds the counts of a completed bucket of the next finer window to the
+*  current bucket of a window. Returns when the current bucket is complete,
+*  after starting the next bucket.
+*
+* Parameters:
+*  ring: window
+*  counts: counts of the completed finer bucket, NULL for the finest window
+*
+* Return:
+*  uint32_t*: counts of the completed bucket, NULL if not yet complete
+*
+*******************************************************************************/
+static uint32_t *hall_health_add(hall_health_ring_t *ring, const uint32_t *counts)
+{
+    uint32_t *bucket = ring->buckets[ring->index];
+    uint32_t event;
+
+    if (counts != NULL)
+    {
+        for (event = 0U; event < HALL_HEALTH_NUM_EVENTS; event++)
+        {
+            bucket[event] += counts[event];
+            ring->sum[event] += counts[event];
+        }
+    }
+
+    if (++ring->ticks < ring->bucket_ticks)
+    {
+        return NULL;
+    }
+    ring->ticks = 0U;
+
+    /* The oldest bucket drops out of the window and becomes the current one */
+    ring->index = (ring->index + 1U < ring->num_buckets) ? (ring->index + 1U) : 0U;
+    for (event = 0U; event < HALL_HEALTH_NUM_EVENTS; event++)
+    {
+        ring->sum[event] -= ring->buckets[ring->index][event];
+        ring->buckets[ring->index][event] = 0U;
+    }
+
+    return bucket;
+}
+
+/*******************************************************************************
+* Function Name: hall_health_reset
+********************************************************************************
+* Summary:
+*  Clears all windows.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_health_reset(void)
+{
+    uint32_t window;
+    uint32_t bucket;
+    uint32_t event;
+    hall_health_ring_t *ring;
+
+    for (window = 0U; window < HALL_HEALTH_NUM_WINDOWS; window++)
+    {
+        ring = &hall_health_rings[window];
+        for (bucket = 0U; bucket < ring->num_buckets; bucket++)
+        {
+            for (event = 0U; event < HALL_HEALTH_NUM_EVENTS; event++)
+            {
+                ring->buckets[bucket][event] = 0U;
+            }
+        }
+        for (event = 0U; event < HALL_HEALTH_NUM_EVENTS; event++)
+        {
+            ring->sum[event] = 0U;
+        }
+        ring->index = 0U;
+        ring->ticks = 0U;
+    }
+    hall_health_ms = 0U;
+}
+
+/*******************************************************************************
+* Function Name: hall_health_event
+********************************************************************************
+* Summary:
+*  Counts an event in the current bucket of the 1 s window. The coarser
+*  windows receive it when the bucket is complete, so the cost per event is
+*  independent of the window lengths.
+*
+* Parameters:
+*  event: event type
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_health_event(hall_health_event_t event)
+{
+    hall_health_ring_t *ring = &hall_health_rings[HALL_HEALTH_WINDOW_1S];
+    uint32_t primask;
+
+    /* Events are counted from interrupts of different priorities */
+    primask = __get_PRIMASK();
+    __disable_irq();
+    ring->buckets[ring->index][event]++;
+    ring->sum[event]++;
+    __set_PRIMASK(primask);
+}
+
+/*******************************************************************************
+* Function Name: hall_health_tick
+********************************************************************************
+* Summary:
+*  Advances the windows. Called every millisecond; every HALL_HEALTH_TICK_MS
+*  the 1 s window moves on by one bucket and the completed bucket is passed
+*  on to the coarser windows. The 1 min and 1 h windows are therefore up to
+*  100 ms and 5 s behind.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_health_tick(void)
+{
+    uint32_t *completed = NULL;
+    uint32_t window;
+    uint32_t primask;
+
+    if (++hall_health_ms < HALL_HEALTH_TICK_MS)
+    {
+        return;
+    }
+    hall_health_ms = 0U;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    for (window = 0U; window < HALL_HEALTH_NUM_WINDOWS; window++)
+    {
+        completed = hall_health_add(&hall_health_rings[window], completed);
+        if (completed == NULL)
+        {
+            break;
+        }
+    }
+    __set_PRIMASK(primask);
+}
+
+/*******************************************************************************
+* Function Name: hall_health_get_counts
+********************************************************************************
+* Summary:
+*  Returns the event counts of a window.
+*
+* Parameters:
+*  window: window to read
+*  counts: destination, HALL_HEALTH_NUM_EVENTS entries
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_health_get_counts(hall_health_window_t window, uint32_t *counts)
+{
+    uint32_t primask;
+    uint32_t event;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    for (event = 0U; event < HALL_HEALTH_NUM_EVENTS; event++)
+    {
+        counts[event] = hall_health_rings[window].sum[event];
+    }
+    __set_PRIMASK(primask);
+}
+
+/*******************************************************************************
+* Function Name: hall_health_get_score
+********************************************************************************
+* Summary:
+*  Calculates the health score of a window as the share of correct hall
+*  events among all events, each error event weighted with
+*  HALL_HEALTH_ERROR_WEIGHT. A window without events scores 100.
+*
+* Parameters:
+*  window: window to score
+*
+* Return:
+*  uint32_t: score from 0 (only errors) to 100 (no errors)
+*
+*******************************************************************************/
+uint32_t hall_health_get_score(hall_health_window_t window)
+{
+    uint32_t counts[HALL_HEALTH_NUM_EVENTS];
+    uint32_t errors;
+    uint32_t total;
+
+    hall_health_get_counts(window, counts);
+    errors = counts[HALL_HEALTH_WHE] + counts[HALL_HEALTH_GLITCH] +
+             counts[HALL_HEALTH_RESYNC] + counts[HALL_HEALTH_STALL];
+    if (errors == 0U)
+    {
+        return 100U;
+    }
+
+    total = counts[HALL_HEALTH_CHE] + (errors * HALL_HEALTH_ERROR_WEIGHT);
+
+    /* Scale the operands down so that the product fits into 32 bit */
+    while (total > (UINT32_MAX / 100U))
+    {
+        total >>= 1;
+        counts[HALL_HEALTH_CHE] >>= 1;
+    }
+
+    return hall_speed_udiv(counts[HALL_HEALTH_CHE] * 100U, total);
+}
+
+/*******************************************************************************
+* Function Name: hall_health_get_status
+********************************************************************************
+* Summary:
+*  Classifies a health score with the HALL_HEALTH_DEGRADED_SCORE and
+*  HALL_HEALTH_FAULT_SCORE thresholds.
+*
+* Parameters:
+*  score: health score
+*
+* Return:
+*  hall_health_status_t: health status
+*
+*******************************************************************************/
+hall_health_status_t hall_health_get_status(uint32_t score)
+{
+    if (score < HALL_HEALTH_FAULT_SCORE)
+    {
+        return HALL_HEALTH_FAULT;
+    }
+
+    return (score < HALL_HEALTH_DEGRADED_SCORE) ? HALL_HEALTH_DEGRADED : HALL_HEALTH_OK;
+}
@@ -0,0 +1,107 @@
+/*******************************************************************************
+* File Name:   hall_health.h
+*
+* Description: Health monitoring of the hall sensor signals from event counts over
+*              sliding windows.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#ifndef HALL_HEALTH_H_
+#define HALL_HEALTH_H_
+
+#include <stdint.h>
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Weight of an error event against a correct hall event in the score */
+#ifndef HALL_HEALTH_ERROR_WEIGHT
+#define HALL_HEALTH_ERROR_WEIGHT            (10U)
+#endif
+
+/* Scores below these thresholds are reported as degraded or faulty */
+#ifndef HALL_HEALTH_DEGRADED_SCORE
+#define HALL_HEALTH_DEGRADED_SCORE          (90U)
+#endif
+
+#ifndef HALL_HEALTH_FAULT_SCORE
+#define HALL_HEALTH_FAULT_SCORE             (50U)
+#endif
+
+/*******************************************************************************
+* Data structure and enumeration
+*******************************************************************************/
+typedef enum
+{
+    HALL_HEALTH_CHE,            /* Correct hall event */
+    HALL_HEALTH_WHE,            /* Wrong hall event */
+    HALL_HEALTH_GLITCH,         /* Rejected glitch */
+    HALL_HEALTH_RESYNC,         /* Resynchronisation to the hall inputs */
+    HALL_HEALTH_STALL,          /* Sector longer than the speed timer range */
+    HALL_HEALTH_NUM_EVENTS
+} hall_health_event_t;
+
+typedef enum
+{
+    HALL_HEALTH_WINDOW_1S,      /* 10 buckets of 100 ms */
+    HALL_HEALTH_WINDOW_1MIN,    /* 12 buckets of 5 s */
+    HALL_HEALTH_WINDOW_1H,      /* 60 buckets of 1 min */
+    HALL_HEALTH_NUM_WINDOWS
+} hall_health_window_t;
+
+typedef enum
+{
+    HALL_HEALTH_OK,
+    HALL_HEALTH_DEGRADED,
+    HALL_HEALTH_FAULT
+} hall_health_status_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void hall_health_reset(void);
+void hall_health_event(hall_health_event_t event);
+void hall_health_tick(void);
+void hall_health_get_counts(hall_health_window_t window, uint32_t *counts);
+uint32_t hall_health_get_score(hall_health_window_t window);
+hall_health_status_t hall_health_get_status(uint32_t score);
+
+#if ENABLE_HEALTH_MONITOR
+#define HALL_HEALTH_COUNT(event)            hall_health_event(event)
+#define HALL_HEALTH_TICK()                  hall_health_tick()
+#else
+#define HALL_HEALTH_COUNT(event)
+#define HALL_HEALTH_TICK()
+#endif
+
+#endif /* HALL_HEALTH_H_ */
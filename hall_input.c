@@ -0,0 +1,224 @@
+/*******************************************************************************
+* File Name:   hall_input.c
+*
+* Description: Reading of the hall sensor inputs with optional oversampling
+*              and majority vote.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "cybsp.h"
+#include "hall_input.h"
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Board mapping for a single access read of the hall inputs: the port input
+ * bits holding the three inputs, and the table translating them into the
+ * hall pattern. Boards without a mapping read the pins one by one. */
+#if defined(TARGET_KIT_XMC45_RELAX_V1) || defined(TARGET_KIT_XMC47_RELAX_V1) || \
+    defined(TARGET_KIT_XMC48_RELAX_ECAT_V1) || defined(TARGET_KIT_XMC_PLT2GO_XMC4200) || \
+    defined(TARGET_KIT_XMC_PLT2GO_XMC4400)
+/* HALL_INPUT_3, HALL_INPUT_2 and HALL_INPUT_1 on P14.5, P14.6 and P14.7 */
+#if (HALL_INPUT_1_PIN != 7U) || (HALL_INPUT_2_PIN != 6U) || (HALL_INPUT_3_PIN != 5U)
+#error "Hall input pins differ from the board mapping in hall_input.c"
+#endif
+#define HALL_INPUT_BITS()                   ((XMC_GPIO_PORT14->IN >> 5U) & 0x07U)
+#define HALL_INPUT_DECODE                   { 0U, 4U, 2U, 6U, 1U, 5U, 3U, 7U }
+
+#elif defined(TARGET_KIT_XMC13_BOOT_001) || defined(TARGET_KIT_XMC14_BOOT_001)
+/* HALL_INPUT_1 on P0.13, HALL_INPUT_3 and HALL_INPUT_2 on P1.0 and P1.1. The
+ * inputs span two ports, so once the POSIF runs its sampled pattern is read
+ * instead; before, the two port loads are issued back to back */
+#if (HALL_INPUT_1_PIN != 13U) || (HALL_INPUT_2_PIN != 1U) || (HALL_INPUT_3_PIN != 0U)
+#error "Hall input pins differ from the board mapping in hall_input.c"
+#endif
+#define HALL_INPUT_BITS()                   (((XMC_GPIO_PORT1->IN & 0x03U) << 1U) | \
+                                             ((XMC_GPIO_PORT0->IN >> 13U) & 0x01U))
+#define HALL_INPUT_DECODE                   { 0U, 1U, 4U, 5U, 2U, 3U, 6U, 7U }
+#define HALL_INPUT_POSIF_PATTERN
+#endif
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+#ifdef HALL_INPUT_DECODE
+/* Hall pattern of every combination of the board's hall input bits */
+static const uint8_t hall_input_decode[8] = HALL_INPUT_DECODE;
+#endif
+
+#if ENABLE_HALL_OVERSAMPLING
+/* Sample spacing in core clock cycles, the SysTick timer clock */
+static uint32_t hall_input_spacing_cycles = 0U;
+#endif
+
+/*******************************************************************************
+* Function Name: hall_input_sample
+********************************************************************************
+* Summary:
+*  Samples the hall input pins once. With a board mapping all inputs are
+*  taken from one port input register load and decoded by a table, so the
+*  inputs are sampled at the same time and cost a single read. On boards
+*  whose inputs span two ports, the pattern last sampled by the running POSIF
+*  is used instead.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint8_t: hall input pattern (HALL_INPUT_3 << 2 | ... | HALL_INPUT_1)
+*
+*******************************************************************************/
+static inline uint8_t hall_input_sample(void)
+{
+#ifdef HALL_INPUT_POSIF_PATTERN
+    /* The POSIF samples all three inputs at the same time */
+    if (XMC_POSIF_IsRunning(HALL_POSIF_HW))
+    {
+        return (uint8_t)XMC_POSIF_HSC_GetLastSampledPattern(HALL_POSIF_HW);
+    }
+#endif
+#ifdef HALL_INPUT_DECODE
+    return hall_input_decode[HALL_INPUT_BITS()];
+#else
+    return (uint8_t)(XMC_GPIO_GetInput(HALL_INPUT_1_PORT, HALL_INPUT_1_PIN) |
+                    (XMC_GPIO_GetInput(HALL_INPUT_2_PORT, HALL_INPUT_2_PIN) << 1) |
+                    (XMC_GPIO_GetInput(HALL_INPUT_3_PORT, HALL_INPUT_3_PIN) << 2));
+#endif
+}
+
+#if ENABLE_HALL_OVERSAMPLING
+/*******************************************************************************
+* Function Name: hall_input_wait
+********************************************************************************
+* Summary:
+*  Waits for the sample spacing by polling the SysTick timer, which counts
+*  down at the core clock. Does not wait while the SysTick timer is stopped.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void hall_input_wait(void)
+{
+    uint32_t reload = SysTick->LOAD + 1U;
+    uint32_t start = SysTick->VAL;
+    uint32_t now;
+    uint32_t elapsed;
+
+    if ((SysTick->CTRL & SysTick_CTRL_ENABLE_Msk) == 0U)
+    {
+        return;
+    }
+
+    do
+    {
+        now = SysTick->VAL;
+        elapsed = (start >= now) ? (start - now) : ((start + reload) - now);
+    } while (elapsed < hall_input_spacing_cycles);
+}
+#endif
+
+/*******************************************************************************
+* Function Name: hall_input_init
+********************************************************************************
+* Summary:
+*  Converts the oversampling spacing into core clock cycles. Called once
+*  after the system clock is set up, before the first hall_input_read().
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_input_init(void)
+{
+#if ENABLE_HALL_OVERSAMPLING
+    hall_input_spacing_cycles = (uint32_t)(((uint64_t)SystemCoreClock * HALL_INPUT_SAMPLE_SPACING_NS) / 1000000000U);
+#endif
+}
+
+/*******************************************************************************
+* Function Name: hall_input_read
+********************************************************************************
+* Summary:
+*  Reads the current hall input pattern. With ENABLE_HALL_OVERSAMPLING the
+*  inputs are sampled HALL_INPUT_OVERSAMPLES times, HALL_INPUT_SAMPLE_SPACING_NS
+*  apart, and each input takes the value seen in the majority of the samples. A sample taken during an edge or a short glitch
+*  is thereby outvoted.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint8_t: hall input pattern (HALL_INPUT_3 << 2 | ... | HALL_INPUT_1)
+*
+*******************************************************************************/
+uint8_t hall_input_read(void)
+{
+#if ENABLE_HALL_OVERSAMPLING
+    uint32_t votes[3] = { 0U, 0U, 0U };
+    uint32_t sample;
+    uint32_t i;
+    uint8_t hall_position = 0U;
+
+    for (i = 0U; i < HALL_INPUT_OVERSAMPLES; i++)
+    {
+        if (i != 0U)
+        {
+            hall_input_wait();
+        }
+
+        sample = hall_input_sample();
+        votes[0] += sample & 0x01U;
+        votes[1] += (sample >> 1) & 0x01U;
+        votes[2] += (sample >> 2) & 0x01U;
+    }
+
+    for (i = 0U; i < 3U; i++)
+    {
+        if (votes[i] > (HALL_INPUT_OVERSAMPLES / 2U))
+        {
+            hall_position |= (uint8_t)(1U << i);
+        }
+    }
+
+    return hall_position;
+#else
+    return hall_input_sample();
+#endif
+}
@@ -0,0 +1,72 @@
+/*******************************************************************************
+* File Name:   hall_input.h
+*
+* Description: Reading of the hall sensor inputs with optional oversampling
+*              and majority vote.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#ifndef HALL_INPUT_H_
+#define HALL_INPUT_H_
+
+#include <stdint.h>
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Number of samples per read, odd so that every vote has a majority */
+#ifndef HALL_INPUT_OVERSAMPLES
+#define HALL_INPUT_OVERSAMPLES              (5U)
+#endif
+
+/* Time between two samples in ns, timed by the SysTick timer */
+#ifndef HALL_INPUT_SAMPLE_SPACING_NS
+#define HALL_INPUT_SAMPLE_SPACING_NS        (1000U)
+#endif
+
+#if ENABLE_HALL_OVERSAMPLING && ((HALL_INPUT_OVERSAMPLES % 2U) == 0U)
+#error "HALL_INPUT_OVERSAMPLES must be odd"
+#endif
+
+/* The spacing must stay well below the 1 ms SysTick period */
+#if ENABLE_HALL_OVERSAMPLING && (HALL_INPUT_SAMPLE_SPACING_NS > 100000U)
+#error "HALL_INPUT_SAMPLE_SPACING_NS must not exceed 100000"
+#endif
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void hall_input_init(void);
+uint8_t hall_input_read(void);
+
+#endif /* HALL_INPUT_H_ */
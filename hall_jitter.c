@@ -0,0 +1,269 @@
+/*******************************************************************************
+* File Name:   hall_jitter.c
+*
+* Description: Log-linear histogram of the sector time jitter.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "cybsp.h"
+#include "hall_jitter.h"
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+#define HALL_JITTER_SUB_COUNT               (1U << HALL_JITTER_SUB_BITS)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static hall_jitter_t hall_jitter;
+
+/* Running mean scaled by 2^HALL_JITTER_MEAN_SHIFT */
+static uint64_t hall_jitter_mean_scaled;
+
+/*******************************************************************************
+* Function Name: hall_jitter_msb
+********************************************************************************
+* Summary:
+*  Returns the position of the most significant set bit. The binary search
+*  takes the same five steps for every value, as the Cortex-M0 of the XMC1000
+*  devices has no count leading zeros instruction.
+*
+* Parameters:
+*  value: non-zero value
+*
+* Return:
+*  uint32_t: bit position, 0 to 31
+*
+*******************************************************************************/
+static uint32_t hall_jitter_msb(uint32_t value)
+{
+    uint32_t msb = 0U;
+
+    if (value >= (1UL << 16))
+    {
+        value >>= 16;
+        msb += 16U;
+    }
+    if (value >= (1UL << 8))
+    {
+        value >>= 8;
+        msb += 8U;
+    }
+    if (value >= (1UL << 4))
+    {
+        value >>= 4;
+        msb += 4U;
+    }
+    if (value >= (1UL << 2))
+    {
+        value >>= 2;
+        msb += 2U;
+    }
+    if (value >= (1UL << 1))
+    {
+        msb += 1U;
+    }
+
+    return msb;
+}
+
+/*******************************************************************************
+* Function Name: hall_jitter_get_bucket
+********************************************************************************
+* Summary:
+*  Maps a deviation to its bucket. Small deviations map linearly, larger ones
+*  to the power of two given by their most significant bit and the linear
+*  sub-bucket given by the HALL_JITTER_SUB_BITS bits below it.
+*
+* Parameters:
+*  value: deviation in ticks
+*
+* Return:
+*  uint32_t: bucket index
+*
+*******************************************************************************/
+static uint32_t hall_jitter_get_bucket(uint32_t value)
+{
+    uint32_t exponent;
+
+    if (value < HALL_JITTER_SUB_COUNT)
+    {
+        return value;
+    }
+
+    exponent = hall_jitter_msb(value) - HALL_JITTER_SUB_BITS;
+
+    return ((exponent + 1U) << HALL_JITTER_SUB_BITS) + ((value >> exponent) & (HALL_JITTER_SUB_COUNT - 1U));
+}
+
+/*******************************************************************************
+* Function Name: hall_jitter_get_bucket_low
+********************************************************************************
+* Summary:
+*  Returns the smallest deviation counted in a bucket.
+*
+* Parameters:
+*  bucket: bucket index
+*
+* Return:
+*  uint32_t: lower bound in ticks
+*
+*******************************************************************************/
+uint32_t hall_jitter_get_bucket_low(uint32_t bucket)
+{
+    uint32_t exponent;
+
+    if (bucket < HALL_JITTER_SUB_COUNT)
+    {
+        return bucket;
+    }
+
+    exponent = (bucket >> HALL_JITTER_SUB_BITS) - 1U;
+
+    return (HALL_JITTER_SUB_COUNT + (bucket & (HALL_JITTER_SUB_COUNT - 1U))) << exponent;
+}
+
+/*******************************************************************************
+* Function Name: hall_jitter_get_bucket_high
+********************************************************************************
+* Summary:
+*  Returns the largest deviation counted in a bucket.
+*
+* Parameters:
+*  bucket: bucket index
+*
+* Return:
+*  uint32_t: upper bound in ticks
+*
+*******************************************************************************/
+uint32_t hall_jitter_get_bucket_high(uint32_t bucket)
+{
+    if (bucket >= (HALL_JITTER_NUM_BUCKETS - 1U))
+    {
+        return UINT32_MAX;
+    }
+
+    return hall_jitter_get_bucket_low(bucket + 1U) - 1U;
+}
+
+/*******************************************************************************
+* Function Name: hall_jitter_reset
+********************************************************************************
+* Summary:
+*  Clears the histogram and restarts the running mean.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_jitter_reset(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    uint32_t bucket;
+
+    __disable_irq();
+    hall_jitter.count = 0U;
+    hall_jitter.mean = 0U;
+    for (bucket = 0U; bucket < HALL_JITTER_NUM_BUCKETS; bucket++)
+    {
+        hall_jitter.buckets[bucket] = 0U;
+    }
+    __set_PRIMASK(primask);
+}
+
+/*******************************************************************************
+* Function Name: hall_jitter_update
+********************************************************************************
+* Summary:
+*  Counts the deviation of a sector time from the running mean and updates
+*  the mean. The first sector time only seeds the mean.
+*
+* Parameters:
+*  sector_ticks: sector time in speed timer ticks
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_jitter_update(uint32_t sector_ticks)
+{
+    uint32_t deviation;
+    uint32_t bucket;
+
+    if ((hall_jitter.count == 0U) && (hall_jitter.mean == 0U))
+    {
+        hall_jitter.mean = sector_ticks;
+        hall_jitter_mean_scaled = (uint64_t)sector_ticks << HALL_JITTER_MEAN_SHIFT;
+        return;
+    }
+
+    deviation = (sector_ticks >= hall_jitter.mean) ? (sector_ticks - hall_jitter.mean) :
+                                                     (hall_jitter.mean - sector_ticks);
+    bucket = hall_jitter_get_bucket(deviation);
+    if (hall_jitter.buckets[bucket] != UINT16_MAX)
+    {
+        hall_jitter.buckets[bucket]++;
+    }
+    hall_jitter.count++;
+
+    /* Exponential moving average */
+    hall_jitter_mean_scaled += sector_ticks;
+    hall_jitter_mean_scaled -= hall_jitter.mean;
+    hall_jitter.mean = (uint32_t)(hall_jitter_mean_scaled >> HALL_JITTER_MEAN_SHIFT);
+}
+
+/*******************************************************************************
+* Function Name: hall_jitter_snapshot
+********************************************************************************
+* Summary:
+*  Copies the histogram consistently with the update in the interrupt.
+*
+* Parameters:
+*  histogram: destination of the histogram
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_jitter_snapshot(hall_jitter_t *histogram)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    *histogram = hall_jitter;
+    __set_PRIMASK(primask);
+}
@@ -0,0 +1,81 @@
+/*******************************************************************************
+* File Name:   hall_jitter.h
+*
+* Description: Log-linear histogram of the sector time jitter.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#ifndef HALL_JITTER_H_
+#define HALL_JITTER_H_
+
+#include <stdint.h>
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Each power of two is split into 2^HALL_JITTER_SUB_BITS linear buckets,
+ * which bounds the relative bucket width to 2^-HALL_JITTER_SUB_BITS */
+#ifndef HALL_JITTER_SUB_BITS
+#define HALL_JITTER_SUB_BITS                (2U)
+#endif
+
+/* The running mean follows the sector time with a weight of
+ * 2^-HALL_JITTER_MEAN_SHIFT per edge */
+#ifndef HALL_JITTER_MEAN_SHIFT
+#define HALL_JITTER_MEAN_SHIFT              (4U)
+#endif
+
+/* Deviations 0 to 2^HALL_JITTER_SUB_BITS - 1 get one bucket each, every
+ * further power of two up to 2^31 gets 2^HALL_JITTER_SUB_BITS buckets */
+#define HALL_JITTER_NUM_BUCKETS             ((33U - HALL_JITTER_SUB_BITS) << HALL_JITTER_SUB_BITS)
+
+/*******************************************************************************
+* Data structure and enumeration
+*******************************************************************************/
+typedef struct
+{
+    uint32_t count;                                 /* Number of deviations */
+    uint32_t mean;                                  /* Running mean of the sector time in ticks */
+    uint16_t buckets[HALL_JITTER_NUM_BUCKETS];      /* Counts, saturating at 0xFFFF */
+} hall_jitter_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void hall_jitter_reset(void);
+void hall_jitter_update(uint32_t sector_ticks);
+void hall_jitter_snapshot(hall_jitter_t *histogram);
+uint32_t hall_jitter_get_bucket_low(uint32_t bucket);
+uint32_t hall_jitter_get_bucket_high(uint32_t bucket);
+
+#endif /* HALL_JITTER_H_ */
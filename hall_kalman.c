@@ -0,0 +1,350 @@
+/*******************************************************************************
+* File Name:   hall_kalman.c
+*
+* Description: Kalman estimator of position, speed and acceleration fed by the
+*              correct hall events.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "cybsp.h"
+#include "hall_kalman.h"
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* The estimator works in the angle domain: hall events are equally spaced in
+ * angle, so every event advances the model by exactly one sector and the
+ * transition matrix is constant. The states are the time of the last event
+ * (position), the sector time (inverse speed) and its change per sector
+ * (acceleration), all in speed timer ticks:
+ *
+ *   t[k+1] = t[k] + T[k] + J[k] / 2
+ *   T[k+1] = T[k] + J[k]
+ *   J[k+1] = J[k]
+ *
+ * The measurement is the captured time between two events. The time state is
+ * kept relative to the last measured event so that it stays small */
+#ifndef HALL_KALMAN_FULL
+#if (UC_FAMILY == XMC4)
+#define HALL_KALMAN_FULL                    (1)
+#else
+#define HALL_KALMAN_FULL                    (0)
+#endif
+#endif
+
+#if HALL_KALMAN_FULL
+/* Measurement noise variance (edge jitter) in ticks^2 */
+#define HALL_KALMAN_MEAS_NOISE              (1.0f)
+
+/* Process noise (white jerk) variance relative to the measurement noise */
+#define HALL_KALMAN_PROCESS_NOISE           (0.01f)
+
+/* Initial variance of the sector time and slope states */
+#define HALL_KALMAN_INITIAL_VARIANCE        (1.0e6f)
+#else
+/* Steady-state gains in Q16, the converged gains of the full filter for a
+ * process to measurement noise ratio of 0.01 */
+#define HALL_KALMAN_GAIN_TIME               (39635)
+#define HALL_KALMAN_GAIN_SECTOR             (18072)
+#define HALL_KALMAN_GAIN_SLOPE              (4120)
+
+/* Fractional bits of the tick states */
+#define HALL_KALMAN_FRAC_BITS               (8U)
+#endif
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+#if HALL_KALMAN_FULL
+/* State {t, T, J} and its covariance */
+static float hall_kalman_state[3];
+static float hall_kalman_cov[3][3];
+#else
+/* State {t, T, J} in ticks with HALL_KALMAN_FRAC_BITS fractional bits */
+static int32_t hall_kalman_state[3];
+#endif
+
+/* Cleared until the first sector time initialises the state */
+static bool hall_kalman_valid = false;
+
+/*******************************************************************************
+* Function Name: hall_kalman_init
+********************************************************************************
+* Summary:
+*  Resets the estimator. The next sector time re-initialises the state.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_kalman_init(void)
+{
+    hall_kalman_valid = false;
+}
+
+/*******************************************************************************
+* Function Name: hall_kalman_update
+********************************************************************************
+* Summary:
+*  Runs one prediction and measurement update for a correct hall event. The
+*  execution time is constant: 3x3 matrix operations for the full filter,
+*  three multiply-adds for the steady-state filter.
+*
+* Parameters:
+*  sector_ticks: captured speed timer value of one hall sector
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_kalman_update(uint32_t sector_ticks)
+{
+#if HALL_KALMAN_FULL
+    static const float q[3][3] =
+    {
+        { 1.0f / 20.0f, 1.0f / 8.0f, 1.0f / 6.0f },
+        { 1.0f / 8.0f,  1.0f / 3.0f, 1.0f / 2.0f },
+        { 1.0f / 6.0f,  1.0f / 2.0f, 1.0f        }
+    };
+    float *x = hall_kalman_state;
+    float (*p)[3] = hall_kalman_cov;
+    float fp[3][3];
+    float gain[3];
+    float residual;
+    float s;
+    uint32_t i;
+    uint32_t j;
+
+    if (!hall_kalman_valid)
+    {
+        x[0] = 0.0f;
+        x[1] = (float)sector_ticks;
+        x[2] = 0.0f;
+        for (i = 0U; i < 3U; i++)
+        {
+            for (j = 0U; j < 3U; j++)
+            {
+                p[i][j] = 0.0f;
+            }
+        }
+        p[0][0] = HALL_KALMAN_MEAS_NOISE;
+        p[1][1] = HALL_KALMAN_INITIAL_VARIANCE;
+        p[2][2] = HALL_KALMAN_INITIAL_VARIANCE;
+        hall_kalman_valid = true;
+        return;
+    }
+
+    /* Prediction x = F * x */
+    x[0] = x[0] + x[1] + (0.5f * x[2]);
+    x[1] = x[1] + x[2];
+
+    /* Prediction P = F * P * F' + Q, F is upper triangular */
+    for (j = 0U; j < 3U; j++)
+    {
+        fp[0][j] = p[0][j] + p[1][j] + (0.5f * p[2][j]);
+        fp[1][j] = p[1][j] + p[2][j];
+        fp[2][j] = p[2][j];
+    }
+    for (i = 0U; i < 3U; i++)
+    {
+        p[i][0] = fp[i][0] + fp[i][1] + (0.5f * fp[i][2]);
+        p[i][1] = fp[i][1] + fp[i][2];
+        p[i][2] = fp[i][2];
+        for (j = 0U; j < 3U; j++)
+        {
+            p[i][j] += HALL_KALMAN_PROCESS_NOISE * HALL_KALMAN_MEAS_NOISE * q[i][j];
+        }
+    }
+
+    /* Measurement update with H = [1 0 0] */
+    residual = (float)sector_ticks - x[0];
+    s = p[0][0] + HALL_KALMAN_MEAS_NOISE;
+    for (i = 0U; i < 3U; i++)
+    {
+        gain[i] = p[i][0] / s;
+        x[i] += gain[i] * residual;
+    }
+    for (i = 0U; i < 3U; i++)
+    {
+        for (j = 0U; j < 3U; j++)
+        {
+            fp[i][j] = p[i][j] - (gain[i] * p[0][j]);
+        }
+    }
+    for (i = 0U; i < 3U; i++)
+    {
+        for (j = 0U; j < 3U; j++)
+        {
+            p[i][j] = fp[i][j];
+        }
+    }
+
+    /* Make the time state relative to the measured event */
+    x[0] -= (float)sector_ticks;
+#else
+    int32_t *x = hall_kalman_state;
+    int32_t measured = (int32_t)((sector_ticks & 0xFFFFU) << HALL_KALMAN_FRAC_BITS);
+    int32_t residual;
+
+    if (!hall_kalman_valid)
+    {
+        x[0] = 0;
+        x[1] = measured;
+        x[2] = 0;
+        hall_kalman_valid = true;
+        return;
+    }
+
+    /* Prediction */
+    x[0] = x[0] + x[1] + (x[2] / 2);
+    x[1] = x[1] + x[2];
+
+    /* Measurement update with the constant gains */
+    residual = measured - x[0];
+    x[0] += (int32_t)(((int64_t)residual * HALL_KALMAN_GAIN_TIME) >> 16);
+    x[1] += (int32_t)(((int64_t)residual * HALL_KALMAN_GAIN_SECTOR) >> 16);
+    x[2] += (int32_t)(((int64_t)residual * HALL_KALMAN_GAIN_SLOPE) >> 16);
+
+    /* Make the time state relative to the measured event */
+    x[0] -= measured;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: hall_kalman_get_sector_ticks
+********************************************************************************
+* Summary:
+*  Returns the estimated sector time, i.e. the inverse of the speed. It can be
+*  passed to hall_speed_get_rpm() and hall_angle_get() instead of the raw
+*  captured value.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t: estimated sector time in speed timer ticks, 0 before the first
+*            correct hall event
+*
+*******************************************************************************/
+uint32_t hall_kalman_get_sector_ticks(void)
+{
+    if (!hall_kalman_valid)
+    {
+        return 0U;
+    }
+#if HALL_KALMAN_FULL
+    return (hall_kalman_state[1] > 0.0f) ? (uint32_t)(hall_kalman_state[1] + 0.5f) : 0U;
+#else
+    return (hall_kalman_state[1] > 0) ?
+            ((uint32_t)hall_kalman_state[1] + (1U << (HALL_KALMAN_FRAC_BITS - 1U))) >> HALL_KALMAN_FRAC_BITS : 0U;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: hall_kalman_predict
+********************************************************************************
+* Summary:
+*  Predicts the time of the sector in progress between two hall events: the
+*  model advanced by one sector, but at least the time that has already
+*  elapsed in the sector. The estimate therefore follows a deceleration or a
+*  stop before the next event is captured. Takes constant time and does not
+*  change the state.
+*
+* Parameters:
+*  elapsed_ticks: speed timer ticks since the last correct hall event
+*
+* Return:
+*  uint32_t: predicted sector time in speed timer ticks, 0 before the first
+*            correct hall event
+*
+*******************************************************************************/
+uint32_t hall_kalman_predict(uint32_t elapsed_ticks)
+{
+    uint32_t predicted = 0U;
+
+    if (!hall_kalman_valid)
+    {
+        return 0U;
+    }
+#if HALL_KALMAN_FULL
+    {
+        float next = hall_kalman_state[1] + hall_kalman_state[2];
+
+        if (next > 0.0f)
+        {
+            predicted = (uint32_t)(next + 0.5f);
+        }
+    }
+#else
+    {
+        int32_t next = hall_kalman_state[1] + hall_kalman_state[2];
+
+        if (next > 0)
+        {
+            predicted = ((uint32_t)next + (1U << (HALL_KALMAN_FRAC_BITS - 1U))) >> HALL_KALMAN_FRAC_BITS;
+        }
+    }
+#endif
+
+    return (elapsed_ticks > predicted) ? elapsed_ticks : predicted;
+}
+
+/*******************************************************************************
+* Function Name: hall_kalman_get_sector_slope
+********************************************************************************
+* Summary:
+*  Returns the estimated change of the sector time per sector. A negative
+*  value means the motor accelerates.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  int32_t: sector time change in speed timer ticks per sector
+*
+*******************************************************************************/
+int32_t hall_kalman_get_sector_slope(void)
+{
+    if (!hall_kalman_valid)
+    {
+        return 0;
+    }
+#if HALL_KALMAN_FULL
+    return (int32_t)hall_kalman_state[2];
+#else
+    return hall_kalman_state[2] / (int32_t)(1U << HALL_KALMAN_FRAC_BITS);
+#endif
+}
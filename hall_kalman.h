@@ -0,0 +1,60 @@
+/*******************************************************************************
+* File Name:   hall_kalman.h
+*
+* Description: Kalman estimator of position, speed and acceleration fed by the
+*              correct hall events.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#ifndef HALL_KALMAN_H_
+#define HALL_KALMAN_H_
+
+#include <stdint.h>
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Selects the full Kalman filter (1) or the steady-state filter with constant
+ * gains (0). Defaults to the full filter in floating point on XMC4000 and the
+ * steady-state filter in fixed point on XMC1000, see hall_kalman.c */
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void hall_kalman_init(void);
+void hall_kalman_update(uint32_t sector_ticks);
+uint32_t hall_kalman_get_sector_ticks(void);
+uint32_t hall_kalman_predict(uint32_t elapsed_ticks);
+int32_t hall_kalman_get_sector_slope(void);
+
+#endif /* HALL_KALMAN_H_ */
@@ -0,0 +1,282 @@
+/*******************************************************************************
+* File Name:   hall_order.c
+*
+* Description: Angle-domain order tracking: per-revolution sector time profile
+*              averaged over many revolutions to expose cogging and eccentricity.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "cybsp.h"
+#include "hall_order.h"
+#include <stddef.h>
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+#if (HALL_ORDER_REVOLUTIONS == 0U) || (HALL_ORDER_REVOLUTIONS > 65536U)
+#error "HALL_ORDER_REVOLUTIONS must be between 1 and 65536"
+#endif
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* Sector time sums per sector of the revolution. One buffer is accumulated
+ * while the other holds the last complete profile */
+static uint32_t hall_order_sums[2][HALL_ORDER_SECTORS_PER_REV];
+
+/* Buffer currently accumulated */
+static volatile uint32_t hall_order_active = 0U;
+
+/* Sector within the electrical period of every canonical hall code, counted
+ * from code 3. Code 3 covers a single sector in every placement, so no split
+ * sector crosses the start of a period */
+static const uint8_t hall_order_code_sector[8] = { 0U, 5U, 1U, 0U, 3U, 4U, 2U, 0U };
+
+/* Slot of the next sector time, and the pole pair and sector of the last
+ * correct hall event */
+static uint32_t hall_order_slot = 0U;
+static uint32_t hall_order_pole_pair = 0U;
+static uint32_t hall_order_period_sector = 0U;
+
+/* Direction of rotation, and whether a hall code has set the position yet */
+static bool hall_order_reverse = false;
+static bool hall_order_positioned = false;
+
+/* Number of sector times in the profile being accumulated */
+static uint32_t hall_order_count = 0U;
+
+/* Number of complete profiles, and the count already returned */
+static volatile uint32_t hall_order_profiles = 0U;
+static uint32_t hall_order_profiles_read = 0U;
+
+/*******************************************************************************
+* Function Name: hall_order_reset
+********************************************************************************
+* Summary:
+*  Discards the profile being accumulated, e.g. after a wrong hall event. The
+*  rotor may have turned back, so sector times are ignored until the next
+*  correct hall event sets the position from its hall code again.
+*  Runs with interrupts disabled, as the correct hall event interrupt that
+*  updates the profile can preempt the wrong hall event one.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_order_reset(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    uint32_t active;
+    uint32_t i;
+
+    __disable_irq();
+    active = hall_order_active;
+    for (i = 0U; i < HALL_ORDER_SECTORS_PER_REV; i++)
+    {
+        hall_order_sums[active][i] = 0U;
+    }
+    hall_order_count = 0U;
+    hall_order_positioned = false;
+    __set_PRIMASK(primask);
+}
+
+/*******************************************************************************
+* Function Name: hall_order_set_code
+********************************************************************************
+* Summary:
+*  Sets the position within the revolution from the canonical hall code of a
+*  correct hall event. The sector within the electrical period follows from
+*  the code. The step from the previous code gives the direction: one or two
+*  sectors forward or back, two being a code of two sectors or a missed edge.
+*  The pole pair advances when the rotor passes code 3 forward (sector 5 to
+*  0) and steps back when it passes it in reverse (sector 0 to 5), so every
+*  slot always refers to the same rotor position. The first code after a reset
+*  only sets the position; the direction of the previous rotation is kept. The sector times that end
+*  at the next event go to the slots of this code, in the order the rotor
+*  passes them. Called from the CHE interrupt after the sector time of the
+*  event was added.
+*
+* Parameters:
+*  hall_code: canonical 120 degree hall code
+*  span: number of sectors covered by the hall code, 1 or 2
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_order_set_code(uint8_t hall_code, uint32_t span)
+{
+    uint32_t sector = hall_order_code_sector[hall_code & 0x07U];
+    uint32_t step = (sector + HALL_SECTORS_PER_PERIOD - hall_order_period_sector) % HALL_SECTORS_PER_PERIOD;
+
+    if (hall_order_positioned)
+    {
+        /* A step of half a period is ambiguous and keeps the direction */
+        if ((step != 0U) && (step != (HALL_SECTORS_PER_PERIOD / 2U)))
+        {
+            hall_order_reverse = (step > (HALL_SECTORS_PER_PERIOD / 2U));
+        }
+
+        /* Passing the start of the period, also across a missed edge */
+        if (!hall_order_reverse && (sector < hall_order_period_sector))
+        {
+            hall_order_pole_pair = (hall_order_pole_pair + 1U) % HALL_MOTOR_POLE_PAIRS;
+        }
+        else if (hall_order_reverse && (sector > hall_order_period_sector))
+        {
+            hall_order_pole_pair = (hall_order_pole_pair + HALL_MOTOR_POLE_PAIRS - 1U) % HALL_MOTOR_POLE_PAIRS;
+        }
+    }
+    hall_order_positioned = true;
+    hall_order_period_sector = sector;
+
+    /* In reverse the rotor enters a code of two sectors at its last sector.
+     * Code 3 covers a single sector, so this stays within the period */
+    if (hall_order_reverse && (span > 1U))
+    {
+        sector += span - 1U;
+    }
+    hall_order_slot = (hall_order_pole_pair * HALL_SECTORS_PER_PERIOD) + sector;
+}
+
+/*******************************************************************************
+* Function Name: hall_order_update
+********************************************************************************
+* Summary:
+*  Adds one sector time to its slot of the revolution. Several sector times
+*  between two correct hall events, e.g. of a code covering two sectors, go
+*  to consecutive slots in the direction of rotation. Called from the CHE
+*  interrupt; constant time except
+*  for clearing the next buffer once every HALL_ORDER_REVOLUTIONS revolutions.
+*
+* Parameters:
+*  sector_ticks: captured speed timer value of one hall sector
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_order_update(uint32_t sector_ticks)
+{
+    uint32_t active = hall_order_active;
+    uint32_t i;
+
+    /* The sector of the time is unknown until a hall code set the position */
+    if (!hall_order_positioned)
+    {
+        return;
+    }
+
+    hall_order_sums[active][hall_order_slot] += sector_ticks & 0xFFFFU;
+    hall_order_slot = (hall_order_slot + (hall_order_reverse ? (HALL_ORDER_SECTORS_PER_REV - 1U) : 1U)) %
+                      HALL_ORDER_SECTORS_PER_REV;
+
+    /* Consecutive sector times fill every slot equally often */
+    if (++hall_order_count < (HALL_ORDER_SECTORS_PER_REV * HALL_ORDER_REVOLUTIONS))
+    {
+        return;
+    }
+    hall_order_count = 0U;
+
+    /* Publish the complete profile and start accumulating into the other buffer */
+    active ^= 1U;
+    for (i = 0U; i < HALL_ORDER_SECTORS_PER_REV; i++)
+    {
+        hall_order_sums[active][i] = 0U;
+    }
+    hall_order_active = active;
+    hall_order_profiles++;
+}
+
+/*******************************************************************************
+* Function Name: hall_order_get_profile
+********************************************************************************
+* Summary:
+*  Returns the last complete profile as the deviation of each sector time from
+*  the mean sector time of the revolution. A positive value is a slow sector.
+*
+* Parameters:
+*  deviation_permille: destination, HALL_ORDER_SECTORS_PER_REV values
+*  profile: optional destination of the profile count, may be NULL
+*
+* Return:
+*  bool: true if a profile that was not returned before is available
+*
+*******************************************************************************/
+bool hall_order_get_profile(int16_t *deviation_permille, uint32_t *profile)
+{
+    uint32_t sums[HALL_ORDER_SECTORS_PER_REV];
+    uint32_t profiles;
+    uint32_t primask;
+    uint64_t total = 0U;
+    uint32_t mean;
+    uint32_t i;
+
+    /* Copy the complete buffer so that a new publication cannot tear it */
+    primask = __get_PRIMASK();
+    __disable_irq();
+    profiles = hall_order_profiles;
+    for (i = 0U; i < HALL_ORDER_SECTORS_PER_REV; i++)
+    {
+        sums[i] = hall_order_sums[hall_order_active ^ 1U][i];
+    }
+    __set_PRIMASK(primask);
+
+    if ((profiles == 0U) || (profiles == hall_order_profiles_read))
+    {
+        return false;
+    }
+    hall_order_profiles_read = profiles;
+
+    for (i = 0U; i < HALL_ORDER_SECTORS_PER_REV; i++)
+    {
+        total += sums[i];
+    }
+    mean = (uint32_t)(total / HALL_ORDER_SECTORS_PER_REV);
+
+    for (i = 0U; i < HALL_ORDER_SECTORS_PER_REV; i++)
+    {
+        deviation_permille[i] = (mean == 0U) ? 0 :
+                (int16_t)(((int64_t)sums[i] - mean) * 1000 / (int64_t)mean);
+    }
+
+    if (profile != NULL)
+    {
+        *profile = profiles;
+    }
+
+    return true;
+}
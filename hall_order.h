@@ -0,0 +1,66 @@
+/*******************************************************************************
+* File Name:   hall_order.h
+*
+* Description: Angle-domain order tracking: per-revolution sector time profile
+*              averaged over many revolutions to expose cogging and eccentricity.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#ifndef HALL_ORDER_H_
+#define HALL_ORDER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "hall_speed.h"
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Hall sectors per mechanical revolution */
+#define HALL_ORDER_SECTORS_PER_REV          (HALL_SECTORS_PER_PERIOD * HALL_MOTOR_POLE_PAIRS)
+
+/* Revolutions averaged into one profile. Sums of 16-bit sector times must
+ * not overflow 32 bit, so at most 65536 */
+#ifndef HALL_ORDER_REVOLUTIONS
+#define HALL_ORDER_REVOLUTIONS              (64U)
+#endif
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void hall_order_reset(void);
+void hall_order_set_code(uint8_t hall_code, uint32_t span);
+void hall_order_update(uint32_t sector_ticks);
+bool hall_order_get_profile(int16_t *deviation_permille, uint32_t *profile);
+
+#endif /* HALL_ORDER_H_ */
@@ -0,0 +1,213 @@
+/*******************************************************************************
+* File Name:   hall_placement.c
+*
+* Description: Decoding of the hall sensor code for different sensor placements
+*              (three sensors at 120 or 60 degrees, or two sensors) into the
+*              canonical 120 degree code used by the rest of the application.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "hall_placement.h"
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Marks a hall code that cannot occur for the selected placement */
+#define HALL_PLACEMENT_INVALID              (0U)
+
+/* Position field of a POSIF hall pattern: current in bits 0-2, expected in 3-5 */
+#define HALL_PLACEMENT_EXPECTED_SHIFT       (3U)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+#if (HALL_SENSOR_PLACEMENT == HALL_PLACEMENT_120)
+/* Canonical code of every hall code, and the code that follows it */
+static const uint8_t hall_placement_canonical[8] = { 0U, 1U, 2U, 3U, 4U, 5U, 6U, 0U };
+static const uint8_t hall_placement_next[8]      = { 0U, 3U, 6U, 2U, 5U, 1U, 4U, 0U };
+
+/* Number of 60 degree sectors covered by every hall code */
+static const uint8_t hall_placement_span[8]      = { 0U, 1U, 1U, 1U, 1U, 1U, 1U, 0U };
+
+#elif (HALL_SENSOR_PLACEMENT == HALL_PLACEMENT_60)
+/* The middle sensor inverted gives the 120 degree code, so the sequence is
+ * 1 -> 3 -> 2 -> 6 -> 4 -> 5 with that bit toggled */
+#define HALL_PLACEMENT_CODE(code)           ((uint8_t)((code) ^ HALL_PLACEMENT_60_MIDDLE_MASK))
+
+static const uint8_t hall_placement_canonical[8] =
+{
+    HALL_PLACEMENT_CODE(0U), HALL_PLACEMENT_CODE(1U), HALL_PLACEMENT_CODE(2U), HALL_PLACEMENT_CODE(3U),
+    HALL_PLACEMENT_CODE(4U), HALL_PLACEMENT_CODE(5U), HALL_PLACEMENT_CODE(6U), HALL_PLACEMENT_CODE(7U)
+};
+/* The canonical codes 0 and 7 do not occur */
+#define HALL_PLACEMENT_SPAN(code)           ((uint8_t)(((HALL_PLACEMENT_CODE(code) % 7U) != 0U) ? 1U : 0U))
+
+static const uint8_t hall_placement_span[8] =
+{
+    HALL_PLACEMENT_SPAN(0U), HALL_PLACEMENT_SPAN(1U), HALL_PLACEMENT_SPAN(2U), HALL_PLACEMENT_SPAN(3U),
+    HALL_PLACEMENT_SPAN(4U), HALL_PLACEMENT_SPAN(5U), HALL_PLACEMENT_SPAN(6U), HALL_PLACEMENT_SPAN(7U)
+};
+
+/* Successor of every canonical code */
+static const uint8_t hall_placement_canonical_next[8] = { 0U, 3U, 6U, 2U, 5U, 1U, 4U, 0U };
+
+#elif (HALL_SENSOR_PLACEMENT == HALL_PLACEMENT_TWO_SENSOR)
+/* Without HALL_INPUT_3 the codes 1 and 5 (sectors 5 and 0) and the codes 2 and
+ * 6 (sectors 2 and 3) merge. Each two-sensor code maps to the canonical code
+ * of its first sector and covers one or two sectors:
+ *   code 1 -> canonical 5, two sectors
+ *   code 3 -> canonical 3, one sector
+ *   code 2 -> canonical 2, two sectors
+ *   code 0 -> canonical 4, one sector */
+static const uint8_t hall_placement_canonical[8] = { 4U, 5U, 2U, 3U, 0U, 0U, 0U, 0U };
+static const uint8_t hall_placement_next[8]      = { 1U, 3U, 0U, 2U, 0U, 0U, 0U, 0U };
+static const uint8_t hall_placement_span[8]      = { 1U, 2U, 2U, 1U, 0U, 0U, 0U, 0U };
+
+#else
+#error "Unsupported HALL_SENSOR_PLACEMENT"
+#endif
+
+/*******************************************************************************
+* Function Name: hall_placement_is_valid
+********************************************************************************
+* Summary:
+*  Checks whether a hall code can occur for the selected placement.
+*
+* Parameters:
+*  hall_code: hall input pattern (HALL_INPUT_3 << 2 | ... | HALL_INPUT_1)
+*
+* Return:
+*  bool: true for a valid code
+*
+*******************************************************************************/
+bool hall_placement_is_valid(uint8_t hall_code)
+{
+    return (hall_placement_span[hall_code & 0x07U] != 0U);
+}
+
+/*******************************************************************************
+* Function Name: hall_placement_to_canonical
+********************************************************************************
+* Summary:
+*  Translates a hall code into the code of a three sensor, 120 degree
+*  placement (sequence 1 -> 3 -> 2 -> 6 -> 4 -> 5). For a code that covers two
+*  sectors, the canonical code of the first sector is returned.
+*
+* Parameters:
+*  hall_code: hall input pattern
+*
+* Return:
+*  uint8_t: canonical code, 0 for an invalid code
+*
+*******************************************************************************/
+uint8_t hall_placement_to_canonical(uint8_t hall_code)
+{
+    hall_code &= 0x07U;
+
+    return hall_placement_is_valid(hall_code) ? hall_placement_canonical[hall_code] : HALL_PLACEMENT_INVALID;
+}
+
+/*******************************************************************************
+* Function Name: hall_placement_get_span
+********************************************************************************
+* Summary:
+*  Returns the number of 60 degree sectors covered by a hall code. A sector
+*  time captured for a code covering two sectors is split into two sector
+*  events so that the estimators always see 60 degree steps.
+*
+* Parameters:
+*  hall_code: hall input pattern
+*
+* Return:
+*  uint32_t: 1 or 2, 0 for an invalid code
+*
+*******************************************************************************/
+uint32_t hall_placement_get_span(uint8_t hall_code)
+{
+    return hall_placement_span[hall_code & 0x07U];
+}
+
+/*******************************************************************************
+* Function Name: hall_placement_get_first_code
+********************************************************************************
+* Summary:
+*  Returns the hall code used to program the POSIF when the current hall
+*  inputs do not show a valid code.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint8_t: hall code of canonical code 1
+*
+*******************************************************************************/
+uint8_t hall_placement_get_first_code(void)
+{
+#if (HALL_SENSOR_PLACEMENT == HALL_PLACEMENT_60)
+    return HALL_PLACEMENT_CODE(1U);
+#else
+    return 1U;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: hall_placement_get_patterns
+********************************************************************************
+* Summary:
+*  Builds the POSIF hall pattern table of the selected placement: each valid
+*  hall code as current pattern and its successor as expected pattern, the
+*  format used by XMC_POSIF_HSC_SetHallPatterns(). Invalid codes are set to 0.
+*
+* Parameters:
+*  patterns: destination, 8 entries indexed by hall code
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_placement_get_patterns(uint8_t *patterns)
+{
+    uint32_t next;
+    uint32_t i;
+
+    for (i = 0U; i < 8U; i++)
+    {
+#if (HALL_SENSOR_PLACEMENT == HALL_PLACEMENT_60)
+        next = HALL_PLACEMENT_CODE(hall_placement_canonical_next[hall_placement_canonical[i]]);
+#else
+        next = hall_placement_next[i];
+#endif
+        patterns[i] = hall_placement_is_valid((uint8_t)i) ?
+                      (uint8_t)(i | (next << HALL_PLACEMENT_EXPECTED_SHIFT)) : 0U;
+    }
+}
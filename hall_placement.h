@@ -0,0 +1,82 @@
+/*******************************************************************************
+* File Name:   hall_placement.h
+*
+* Description: Decoding of the hall sensor code for different sensor placements
+*              (three sensors at 120 or 60 degrees, or two sensors) into the
+*              canonical 120 degree code used by the rest of the application.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#ifndef HALL_PLACEMENT_H_
+#define HALL_PLACEMENT_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Supported hall sensor placements */
+#define HALL_PLACEMENT_120                  (0)     /* Three sensors, 120 degrees apart */
+#define HALL_PLACEMENT_60                   (1)     /* Three sensors, 60 degrees apart */
+#define HALL_PLACEMENT_TWO_SENSOR           (2)     /* HALL_INPUT_1 and HALL_INPUT_2, 120 degrees apart */
+
+/* For 60 degree placement: hall code bit of the middle sensor, which is the
+ * inverse of the corresponding sensor of a 120 degree placement */
+#ifndef HALL_PLACEMENT_60_MIDDLE_MASK
+#define HALL_PLACEMENT_60_MIDDLE_MASK       (0x02U)
+#endif
+
+/* Hall code bits of the CCU8 simulated hall signals that are inverted, and
+ * that are held low, so that the simulation matches the selected placement */
+#if (HALL_SENSOR_PLACEMENT == HALL_PLACEMENT_60)
+#define HALL_PLACEMENT_SIM_INVERTED         (HALL_PLACEMENT_60_MIDDLE_MASK)
+#else
+#define HALL_PLACEMENT_SIM_INVERTED         (0x00U)
+#endif
+#if (HALL_SENSOR_PLACEMENT == HALL_PLACEMENT_TWO_SENSOR)
+#define HALL_PLACEMENT_SIM_HELD_LOW         (0x04U)
+#else
+#define HALL_PLACEMENT_SIM_HELD_LOW         (0x00U)
+#endif
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool hall_placement_is_valid(uint8_t hall_code);
+uint8_t hall_placement_to_canonical(uint8_t hall_code);
+uint32_t hall_placement_get_span(uint8_t hall_code);
+uint8_t hall_placement_get_first_code(void);
+void hall_placement_get_patterns(uint8_t *patterns);
+
+#endif /* HALL_PLACEMENT_H_ */
@@ -0,0 +1,265 @@
+/*******************************************************************************
+* File Name:   hall_resync.c
+*
+* Description: Missing hall edge detection and resynchronisation of the POSIF
+*              hall pattern sequence.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "cybsp.h"
+#include "hall_placement.h"
+#include "hall_resync.h"
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Expected pattern field of a POSIF hall pattern */
+#define HALL_RESYNC_EXPECTED(pattern)       ((uint8_t)(((pattern) >> 3U) & 0x07U))
+
+/* Longest walk through the hall sequence */
+#define HALL_RESYNC_MAX_STEPS               (6U)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* Programmed hall patterns, indexed by hall code */
+static const uint8_t *hall_resync_patterns;
+
+/* Hall code of the sector in progress */
+static uint8_t hall_resync_code;
+
+/* Last 60 degree sector time, base of the edge prediction */
+static uint32_t hall_resync_sector_ticks;
+
+static hall_resync_stats_t hall_resync_stats;
+
+/*******************************************************************************
+* Function Name: hall_resync_predict
+********************************************************************************
+* Summary:
+*  Predicts how long a hall code lasts from the last sector time.
+*
+* Parameters:
+*  hall_code: hall input pattern
+*
+* Return:
+*  uint32_t: predicted speed timer ticks, 0 without a sector time
+*
+*******************************************************************************/
+static uint32_t hall_resync_predict(uint8_t hall_code)
+{
+    return hall_resync_sector_ticks * hall_placement_get_span(hall_code);
+}
+
+/*******************************************************************************
+* Function Name: hall_resync_reset
+********************************************************************************
+* Summary:
+*  Starts tracking the hall sequence. Called when the hall capture starts.
+*
+* Parameters:
+*  patterns: POSIF hall patterns indexed by hall code, kept by reference
+*  hall_code: hall input pattern at the start
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_resync_reset(const uint8_t *patterns, uint8_t hall_code)
+{
+    hall_resync_patterns = patterns;
+    hall_resync_code = hall_code;
+    hall_resync_sector_ticks = 0U;
+}
+
+/*******************************************************************************
+* Function Name: hall_resync_edge
+********************************************************************************
+* Summary:
+*  Records a correct hall event. Called from the correct hall event interrupt.
+*
+* Parameters:
+*  hall_code: hall input pattern after the event
+*  sector_ticks: 60 degree sector time, 0 if not available
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_resync_edge(uint8_t hall_code, uint32_t sector_ticks)
+{
+    hall_resync_code = hall_code;
+    if (sector_ticks != 0U)
+    {
+        hall_resync_sector_ticks = sector_ticks;
+    }
+}
+
+/*******************************************************************************
+* Function Name: hall_resync_get_code
+********************************************************************************
+* Summary:
+*  Returns the hall code of the sector in progress.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint8_t: hall code
+*
+*******************************************************************************/
+uint8_t hall_resync_get_code(void)
+{
+    return hall_resync_code;
+}
+
+/*******************************************************************************
+* Function Name: hall_resync_get_next_code
+********************************************************************************
+* Summary:
+*  Returns the hall code expected after a hall code.
+*
+* Parameters:
+*  hall_code: hall input pattern
+*
+* Return:
+*  uint8_t: expected hall code
+*
+*******************************************************************************/
+uint8_t hall_resync_get_next_code(uint8_t hall_code)
+{
+    return HALL_RESYNC_EXPECTED(hall_resync_patterns[hall_code & 0x07U]);
+}
+
+/*******************************************************************************
+* Function Name: hall_resync_is_overdue
+********************************************************************************
+* Summary:
+*  Checks whether the next edge is overdue, i.e. the current code lasts
+*  HALL_RESYNC_OVERDUE_FACTOR times longer than predicted.
+*
+* Parameters:
+*  elapsed_ticks: speed timer ticks since the last edge
+*
+* Return:
+*  bool: true if the edge is overdue
+*
+*******************************************************************************/
+bool hall_resync_is_overdue(uint32_t elapsed_ticks)
+{
+    uint32_t predicted = hall_resync_predict(hall_resync_code);
+
+    return (predicted != 0U) && (elapsed_ticks > (predicted * HALL_RESYNC_OVERDUE_FACTOR));
+}
+
+/*******************************************************************************
+* Function Name: hall_resync_recover
+********************************************************************************
+* Summary:
+*  Classifies a wrong hall event from the hall code sampled by the POSIF and
+*  makes it the current code. A code two steps ahead in the sequence is a
+*  single missed edge; its time is accepted when it matches the prediction
+*  for the two skipped codes within a factor of two. An invalid code, or the
+*  current one, is a glitch and the current code is kept. Anything else
+*  loses the position tracking.
+*
+* Parameters:
+*  hall_code: hall input pattern sampled by the POSIF
+*  elapsed_ticks: speed timer ticks since the last edge
+*  sectors: number of 60 degree sectors covered by elapsed_ticks, only set
+*           for HALL_RESYNC_MISSED_EDGE
+*
+* Return:
+*  hall_resync_result_t: classification of the event
+*
+*******************************************************************************/
+hall_resync_result_t hall_resync_recover(uint8_t hall_code, uint32_t elapsed_ticks, uint32_t *sectors)
+{
+    uint8_t code = hall_resync_code;
+    uint32_t steps = 0U;
+    uint32_t span = 0U;
+    uint32_t predicted = 0U;
+
+    hall_code &= 0x07U;
+    if (!hall_placement_is_valid(hall_code) || (hall_code == hall_resync_code))
+    {
+        hall_resync_stats.glitches++;
+        return HALL_RESYNC_GLITCH;
+    }
+
+    /* Walk the expected sequence from the current code to the sampled one */
+    while ((code != hall_code) && (steps < HALL_RESYNC_MAX_STEPS))
+    {
+        span += hall_placement_get_span(code);
+        predicted += hall_resync_predict(code);
+        code = HALL_RESYNC_EXPECTED(hall_resync_patterns[code]);
+        steps++;
+    }
+    hall_resync_code = hall_code;
+
+    if ((steps == 2U) && (code == hall_code) && (predicted != 0U) &&
+        (elapsed_ticks > (predicted / 2U)) && (elapsed_ticks < (predicted * 2U)))
+    {
+        hall_resync_stats.missed_edges++;
+        hall_resync_stats.interpolated += span;
+        *sectors = span;
+        return HALL_RESYNC_MISSED_EDGE;
+    }
+
+    /* Timing across the jump is unknown, the prediction restarts */
+    hall_resync_sector_ticks = 0U;
+    hall_resync_stats.lost++;
+    return HALL_RESYNC_LOST;
+}
+
+/*******************************************************************************
+* Function Name: hall_resync_get_stats
+********************************************************************************
+* Summary:
+*  Returns the resynchronisation counters.
+*
+* Parameters:
+*  stats: destination of the counters
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_resync_get_stats(hall_resync_stats_t *stats)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    *stats = hall_resync_stats;
+    __set_PRIMASK(primask);
+}
@@ -0,0 +1,83 @@
+/*******************************************************************************
+* File Name:   hall_resync.h
+*
+* Description: Missing hall edge detection and resynchronisation of the POSIF
+*              hall pattern sequence.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#ifndef HALL_RESYNC_H_
+#define HALL_RESYNC_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* A hall code lasting longer than this multiple of its predicted time is
+ * checked for a missed edge */
+#ifndef HALL_RESYNC_OVERDUE_FACTOR
+#define HALL_RESYNC_OVERDUE_FACTOR          (2U)
+#endif
+
+/*******************************************************************************
+* Data structure and enumeration
+*******************************************************************************/
+typedef enum
+{
+    HALL_RESYNC_GLITCH,         /* Hall inputs back at (or not yet past) the current code */
+    HALL_RESYNC_MISSED_EDGE,    /* One edge missed, the skipped sectors are interpolated */
+    HALL_RESYNC_LOST            /* Position jumped, timing restarts */
+} hall_resync_result_t;
+
+typedef struct
+{
+    uint32_t glitches;          /* Wrong hall events without a position change */
+    uint32_t missed_edges;      /* Recovered single missed edges */
+    uint32_t lost;              /* Resynchronisations without usable timing */
+    uint32_t interpolated;      /* Sector times interpolated after a missed edge */
+} hall_resync_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void hall_resync_reset(const uint8_t *patterns, uint8_t hall_code);
+void hall_resync_edge(uint8_t hall_code, uint32_t sector_ticks);
+uint8_t hall_resync_get_code(void);
+uint8_t hall_resync_get_next_code(uint8_t hall_code);
+bool hall_resync_is_overdue(uint32_t elapsed_ticks);
+hall_resync_result_t hall_resync_recover(uint8_t hall_code, uint32_t elapsed_ticks, uint32_t *sectors);
+void hall_resync_get_stats(hall_resync_stats_t *stats);
+
+#endif /* HALL_RESYNC_H_ */
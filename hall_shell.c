@@ -0,0 +1,276 @@
+/*******************************************************************************
+* File Name:   hall_shell.c
+*
+* Description: Line based command shell on the debug UART. The main loop polls the
+*              received characters; a command runs when its line is complete.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "cybsp.h"
+#include "hall_shell.h"
+#include "hall_health.h"
+#include <stdio.h>
+#include <string.h>
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+#define HALL_SHELL_UART_HW                  (CYBSP_DEBUG_UART_HW)
+#define HALL_SHELL_PROMPT                   "> "
+
+/*******************************************************************************
+* Data structure and enumeration
+*******************************************************************************/
+typedef struct
+{
+    const char *name;
+    const char *help;
+    void (*handler)(void);
+} hall_shell_command_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void hall_shell_help(void);
+#if ENABLE_HEALTH_MONITOR
+static void hall_shell_health(void);
+#endif
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static const hall_shell_command_t hall_shell_commands[] =
+{
+    { "help",   "list the commands",                        hall_shell_help },
+    #if ENABLE_HEALTH_MONITOR
+    { "health", "print the hall event counts and scores",   hall_shell_health },
+    #endif
+};
+
+#define HALL_SHELL_NUM_COMMANDS             (sizeof(hall_shell_commands) / sizeof(hall_shell_commands[0]))
+
+/* Command line being received and its length */
+static char hall_shell_line[HALL_SHELL_LINE_SIZE + 1U];
+static uint32_t hall_shell_length = 0U;
+
+/*******************************************************************************
+* Function Name: hall_shell_help
+********************************************************************************
+* Summary:
+*  Prints the commands with their description.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void hall_shell_help(void)
+{
+    uint32_t i;
+
+    for (i = 0U; i < HALL_SHELL_NUM_COMMANDS; i++)
+    {
+        printf("  %-8s %s\r\n", hall_shell_commands[i].name, hall_shell_commands[i].help);
+    }
+}
+
+#if ENABLE_HEALTH_MONITOR
+/*******************************************************************************
+* Function Name: hall_shell_health
+********************************************************************************
+* Summary:
+*  Prints the event counts, score and rating of every health window.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void hall_shell_health(void)
+{
+    static const char *const window_names[HALL_HEALTH_NUM_WINDOWS] = { "1s", "1min", "1h" };
+    static const char *const status_names[] = { "ok", "degraded", "fault" };
+    uint32_t counts[HALL_HEALTH_NUM_EVENTS];
+    uint32_t window;
+    uint32_t score;
+
+    printf("  window      che      whe   glitch   resync    stall  score\r\n");
+    for (window = 0U; window < HALL_HEALTH_NUM_WINDOWS; window++)
+    {
+        hall_health_get_counts((hall_health_window_t)window, counts);
+        score = hall_health_get_score((hall_health_window_t)window);
+        printf("  %-6s %8lu %8lu %8lu %8lu %8lu  %3lu %s\r\n", window_names[window],
+                (unsigned long)counts[HALL_HEALTH_CHE], (unsigned long)counts[HALL_HEALTH_WHE],
+                (unsigned long)counts[HALL_HEALTH_GLITCH], (unsigned long)counts[HALL_HEALTH_RESYNC],
+                (unsigned long)counts[HALL_HEALTH_STALL], (unsigned long)score,
+                status_names[hall_health_get_status(score)]);
+    }
+}
+#endif
+
+/*******************************************************************************
+* Function Name: hall_shell_execute
+********************************************************************************
+* Summary:
+*  Runs the command of a complete line.
+*
+* Parameters:
+*  line: command line, without the line end
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void hall_shell_execute(const char *line)
+{
+    uint32_t i;
+
+    for (i = 0U; i < HALL_SHELL_NUM_COMMANDS; i++)
+    {
+        if (strcmp(line, hall_shell_commands[i].name) == 0)
+        {
+            hall_shell_commands[i].handler();
+            return;
+        }
+    }
+    printf("Unknown command '%s', type 'help'\r\n", line);
+}
+
+/*******************************************************************************
+* Function Name: hall_shell_init
+********************************************************************************
+* Summary:
+*  Clears the command line and prints the prompt. Called after retarget-io
+*  is initialized.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_shell_init(void)
+{
+    hall_shell_length = 0U;
+    printf(HALL_SHELL_PROMPT);
+}
+
+/*******************************************************************************
+* Function Name: hall_shell_input
+********************************************************************************
+* Summary:
+*  Adds a received character to the command line and echoes it. A carriage
+*  return or line feed runs the command; backspace removes the last
+*  character. Characters beyond HALL_SHELL_LINE_SIZE are dropped.
+*
+* Parameters:
+*  c: received character
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_shell_input(char c)
+{
+    if ((c == '\r') || (c == '\n'))
+    {
+        printf("\r\n");
+        if (hall_shell_length != 0U)
+        {
+            hall_shell_line[hall_shell_length] = '\0';
+            hall_shell_execute(hall_shell_line);
+            hall_shell_length = 0U;
+        }
+        printf(HALL_SHELL_PROMPT);
+    }
+    else if ((c == '\b') || (c == 0x7F))
+    {
+        if (hall_shell_length != 0U)
+        {
+            hall_shell_length--;
+            printf("\b \b");
+        }
+    }
+    else if ((c >= ' ') && (hall_shell_length < HALL_SHELL_LINE_SIZE))
+    {
+        hall_shell_line[hall_shell_length++] = c;
+        putchar(c);
+    }
+    else
+    {
+        /* Ignore control characters and characters beyond the line size */
+    }
+    fflush(stdout);
+}
+
+/*******************************************************************************
+* Function Name: hall_shell_poll
+********************************************************************************
+* Summary:
+*  Passes all characters received on the debug UART to the shell. Called
+*  from the main loop; does not wait for input. The receive FIFO is read if
+*  the board configuration enables it, the receive buffer otherwise.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_shell_poll(void)
+{
+    const uint32_t receive_flags = (uint32_t)XMC_UART_CH_STATUS_FLAG_RECEIVE_INDICATION |
+                                   (uint32_t)XMC_UART_CH_STATUS_FLAG_ALTERNATIVE_RECEIVE_INDICATION;
+
+    if ((HALL_SHELL_UART_HW->RBCTR & USIC_CH_RBCTR_SIZE_Msk) != 0U)
+    {
+        while (!XMC_USIC_CH_RXFIFO_IsEmpty(HALL_SHELL_UART_HW))
+        {
+            hall_shell_input((char)XMC_UART_CH_GetReceivedData(HALL_SHELL_UART_HW));
+        }
+    }
+    else
+    {
+        while ((XMC_UART_CH_GetStatusFlag(HALL_SHELL_UART_HW) & receive_flags) != 0U)
+        {
+            XMC_UART_CH_ClearStatusFlag(HALL_SHELL_UART_HW, receive_flags);
+            hall_shell_input((char)XMC_UART_CH_GetReceivedData(HALL_SHELL_UART_HW));
+        }
+    }
+}
@@ -0,0 +1,369 @@
+/*******************************************************************************
+* File Name:   hall_spectrum.c
+*
+* Description: Speed ripple spectrum: the per-sector speed is resampled onto a
+*              uniform time grid and transformed with the CMSIS-DSP real FFT to
+*              report the ripple at selected mechanical orders (XMC4000 only).
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "cybsp.h"
+#include "hall_spectrum.h"
+#include "hall_speed.h"
+
+#if ENABLE_SPEED_SPECTRUM
+
+#if (UC_FAMILY != XMC4)
+#error "The speed spectrum analysis requires an XMC4000 device"
+#endif
+
+#include "arm_math.h"
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Speed unit of the resampled values: sectors per 2^24 ticks. Only the ratio
+ * to the mean speed is reported, so the unit cancels out */
+#define HALL_SPECTRUM_SPEED_SCALE           (16777216.0f)
+
+/* Fractional bits of the grid step and phase */
+#define HALL_SPECTRUM_FRAC_BITS             (8U)
+
+#if (HALL_SPECTRUM_BLOCK_SIZE % HALL_SPECTRUM_SAMPLES_PER_REV) != 0
+#error "HALL_SPECTRUM_SAMPLES_PER_REV must divide HALL_SPECTRUM_BLOCK_SIZE"
+#endif
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static const uint8_t hall_spectrum_orders[HALL_SPECTRUM_NUM_ORDERS] = HALL_SPECTRUM_ORDERS;
+
+static arm_rfft_fast_instance_f32 hall_spectrum_fft;
+
+/* Hann window, resampled speed block and FFT output */
+static float32_t hall_spectrum_window[HALL_SPECTRUM_BLOCK_SIZE];
+static float32_t hall_spectrum_samples[HALL_SPECTRUM_BLOCK_SIZE];
+static float32_t hall_spectrum_bins[HALL_SPECTRUM_BLOCK_SIZE];
+
+/* Number of resampled values in the current block */
+static uint32_t hall_spectrum_count = 0U;
+
+/* Part of the current grid interval covered so far, in ticks with
+ * HALL_SPECTRUM_FRAC_BITS fractional bits, and the integral of the speed
+ * over it */
+static uint32_t hall_spectrum_fill = 0U;
+static float32_t hall_spectrum_integral = 0.0f;
+
+/* Grid step of the current block in speed timer ticks, with
+ * HALL_SPECTRUM_FRAC_BITS fractional bits. 0 until the first sector time is
+ * known */
+static uint32_t hall_spectrum_step = 0U;
+
+/* Sum of the sector times that contributed to the current block */
+static uint32_t hall_spectrum_ticks = 0U;
+static uint32_t hall_spectrum_sectors = 0U;
+
+static hall_spectrum_result_t hall_spectrum_result;
+
+/*******************************************************************************
+* Function Name: hall_spectrum_get_step
+********************************************************************************
+* Summary:
+*  Returns the grid step for a mean sector time, so that a block spans a
+*  whole number of revolutions and the orders fall onto bins at any speed.
+*  The fractional bits keep the step exact to 1/256 tick at high speed.
+*
+* Parameters:
+*  ticks: sum of the sector times in speed timer ticks
+*  sectors: number of sector times in the sum
+*
+* Return:
+*  uint32_t: grid step in speed timer ticks with HALL_SPECTRUM_FRAC_BITS
+*            fractional bits, at least one tick
+*
+*******************************************************************************/
+static uint32_t hall_spectrum_get_step(uint32_t ticks, uint32_t sectors)
+{
+    uint32_t step = (uint32_t)(((uint64_t)ticks * HALL_SECTORS_PER_PERIOD * HALL_MOTOR_POLE_PAIRS <<
+                                HALL_SPECTRUM_FRAC_BITS) / ((uint64_t)sectors * HALL_SPECTRUM_SAMPLES_PER_REV));
+
+    return (step >= (1U << HALL_SPECTRUM_FRAC_BITS)) ? step : (1U << HALL_SPECTRUM_FRAC_BITS);
+}
+
+/*******************************************************************************
+* Function Name: hall_spectrum_hann_gain
+********************************************************************************
+* Summary:
+*  Returns the relative amplitude response of the Hann window for a tone
+*  that lies between two bins, (sin(pi d) / (pi d)) / (1 - d^2). Dividing by
+*  it corrects the scalloping loss of up to 1.42 dB at half a bin.
+*
+* Parameters:
+*  offset: distance d of the tone from the bin centre, -0.5 to 0.5 bins
+*
+* Return:
+*  float32_t: amplitude response, 1 at the bin centre
+*
+*******************************************************************************/
+static float32_t hall_spectrum_hann_gain(float32_t offset)
+{
+    float32_t x = PI * offset;
+
+    if ((offset > -0.001f) && (offset < 0.001f))
+    {
+        return 1.0f;
+    }
+
+    return (arm_sin_f32(x) / x) / (1.0f - (offset * offset));
+}
+
+/*******************************************************************************
+* Function Name: hall_spectrum_analyse
+********************************************************************************
+* Summary:
+*  Transforms a full block of resampled speed values and converts the bins of
+*  the configured mechanical orders into ripple amplitudes.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void hall_spectrum_analyse(void)
+{
+    float32_t mean;
+    float32_t re;
+    float32_t im;
+    float32_t magnitude;
+    float32_t bin_per_order;
+    float32_t position;
+    hall_spectrum_result_t result;
+    uint32_t primask;
+    uint32_t mean_ticks;
+    uint32_t bin;
+    uint32_t i;
+
+    arm_mean_f32(hall_spectrum_samples, HALL_SPECTRUM_BLOCK_SIZE, &mean);
+    arm_offset_f32(hall_spectrum_samples, -mean, hall_spectrum_samples, HALL_SPECTRUM_BLOCK_SIZE);
+    arm_mult_f32(hall_spectrum_samples, hall_spectrum_window, hall_spectrum_samples, HALL_SPECTRUM_BLOCK_SIZE);
+    arm_rfft_fast_f32(&hall_spectrum_fft, hall_spectrum_samples, hall_spectrum_bins, 0U);
+
+    mean_ticks = hall_spectrum_ticks / hall_spectrum_sectors;
+
+    /* One mechanical revolution lasts sectors * pole pairs * mean sector time.
+     * This is BLOCK_SIZE / SAMPLES_PER_REV bins when the speed is the same as
+     * in the previous block; a speed change moves the orders off the bins */
+    bin_per_order = ((float32_t)HALL_SPECTRUM_BLOCK_SIZE * hall_spectrum_step * hall_spectrum_sectors) /
+                    ((float32_t)HALL_SECTORS_PER_PERIOD * HALL_MOTOR_POLE_PAIRS * hall_spectrum_ticks *
+                     (float32_t)(1U << HALL_SPECTRUM_FRAC_BITS));
+
+    for (i = 0U; i < HALL_SPECTRUM_NUM_ORDERS; i++)
+    {
+        position = bin_per_order * hall_spectrum_orders[i];
+        bin = (uint32_t)(position + 0.5f);
+        magnitude = 0.0f;
+
+        /* Bin 0 holds DC and Nyquist, orders above Nyquist are not reported */
+        if ((bin > 0U) && (bin < (HALL_SPECTRUM_BLOCK_SIZE / 2U)) && (mean > 0.0f))
+        {
+            re = hall_spectrum_bins[2U * bin];
+            im = hall_spectrum_bins[(2U * bin) + 1U];
+            arm_sqrt_f32((re * re) + (im * im), &magnitude);
+
+            /* Hann window coherent gain is 0.5, single sided amplitude is 2/N */
+            magnitude = (magnitude * 4.0f) /
+                        ((float32_t)HALL_SPECTRUM_BLOCK_SIZE * mean * hall_spectrum_hann_gain(position - (float32_t)bin));
+        }
+        result.ripple_permille[i] = (uint16_t)((magnitude * 1000.0f) + 0.5f);
+    }
+
+    result.mean_sector_ticks = mean_ticks;
+    result.block = hall_spectrum_result.block + 1U;
+
+    /* The result is read from the SysTick handler */
+    primask = __get_PRIMASK();
+    __disable_irq();
+    hall_spectrum_result = result;
+    __set_PRIMASK(primask);
+
+    /* The next block is resampled with the mean speed of this one */
+    hall_spectrum_step = hall_spectrum_get_step(hall_spectrum_ticks, hall_spectrum_sectors);
+
+    hall_spectrum_count = 0U;
+    hall_spectrum_ticks = 0U;
+    hall_spectrum_sectors = 0U;
+}
+#endif
+
+/*******************************************************************************
+* Function Name: hall_spectrum_init
+********************************************************************************
+* Summary:
+*  Initialises the real FFT and the Hann window and clears the results.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_spectrum_init(void)
+{
+#if ENABLE_SPEED_SPECTRUM
+    uint32_t i;
+
+    (void)arm_rfft_fast_init_f32(&hall_spectrum_fft, HALL_SPECTRUM_BLOCK_SIZE);
+
+    for (i = 0U; i < HALL_SPECTRUM_BLOCK_SIZE; i++)
+    {
+        hall_spectrum_window[i] = 0.5f - (0.5f * arm_cos_f32((2.0f * PI * i) / HALL_SPECTRUM_BLOCK_SIZE));
+    }
+
+    hall_spectrum_count = 0U;
+    hall_spectrum_fill = 0U;
+    hall_spectrum_integral = 0.0f;
+    hall_spectrum_step = 0U;
+    hall_spectrum_ticks = 0U;
+    hall_spectrum_sectors = 0U;
+    hall_spectrum_result.block = 0U;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: hall_spectrum_process
+********************************************************************************
+* Summary:
+*  Resamples a block of sector times onto a uniform grid. The speed is held
+*  constant over each sector, and every grid value is the mean speed over its
+*  grid interval. Unlike picking the speed at each grid point, this does not
+*  weight the sectors by the number of grid points that happen to fall into
+*  them. The grid step is fixed within a block and taken from the mean sector
+*  time of the previous block, or of the first sector.
+*  Sector times above 16 bit, which only a stopped motor produces, are
+*  skipped.
+*  Runs the FFT whenever a block is complete.
+*
+* Parameters:
+*  sector_ticks: captured sector times
+*  count: number of sector times
+*
+* Return:
+*  bool: true if a new result is available
+*
+*******************************************************************************/
+bool hall_spectrum_process(const uint32_t *sector_ticks, uint32_t count)
+{
+    bool done = false;
+#if ENABLE_SPEED_SPECTRUM
+    float32_t speed;
+    uint32_t ticks;
+    uint32_t remaining;
+    uint32_t room;
+    uint32_t i;
+
+    for (i = 0U; i < count; i++)
+    {
+        ticks = sector_ticks[i];
+        if ((ticks == 0U) || (ticks > 0xFFFFU))
+        {
+            continue;
+        }
+        speed = HALL_SPECTRUM_SPEED_SCALE / (float32_t)ticks;
+
+        if (hall_spectrum_step == 0U)
+        {
+            hall_spectrum_step = hall_spectrum_get_step(ticks, 1U);
+        }
+
+        hall_spectrum_ticks += ticks;
+        hall_spectrum_sectors++;
+
+        /* Spread the sector over the grid intervals it covers and emit every
+         * interval that it completes */
+        remaining = ticks << HALL_SPECTRUM_FRAC_BITS;
+        while (remaining != 0U)
+        {
+            room = hall_spectrum_step - hall_spectrum_fill;
+            if (remaining < room)
+            {
+                hall_spectrum_integral += speed * (float32_t)remaining;
+                hall_spectrum_fill += remaining;
+                remaining = 0U;
+            }
+            else
+            {
+                hall_spectrum_integral += speed * (float32_t)room;
+                remaining -= room;
+                hall_spectrum_samples[hall_spectrum_count++] = hall_spectrum_integral / (float32_t)hall_spectrum_step;
+                hall_spectrum_integral = 0.0f;
+                hall_spectrum_fill = 0U;
+
+                if (hall_spectrum_count == HALL_SPECTRUM_BLOCK_SIZE)
+                {
+                    hall_spectrum_analyse();
+                    done = true;
+                }
+            }
+        }
+    }
+#else
+    (void)sector_ticks;
+    (void)count;
+#endif
+    return done;
+}
+
+/*******************************************************************************
+* Function Name: hall_spectrum_get_result
+********************************************************************************
+* Summary:
+*  Copies the result of the last complete block.
+*
+* Parameters:
+*  result: destination
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_spectrum_get_result(hall_spectrum_result_t *result)
+{
+#if ENABLE_SPEED_SPECTRUM
+    *result = hall_spectrum_result;
+#else
+    (void)result;
+#endif
+}
@@ -0,0 +1,84 @@
+/*******************************************************************************
+* File Name:   hall_spectrum.h
+*
+* Description: Speed ripple spectrum: the per-sector speed is resampled onto a
+*              uniform time grid and transformed with the CMSIS-DSP real FFT to
+*              report the ripple at selected mechanical orders (XMC4000 only).
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#ifndef HALL_SPECTRUM_H_
+#define HALL_SPECTRUM_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Number of resampled speed values per FFT block */
+#define HALL_SPECTRUM_BLOCK_SIZE            (256U)
+
+/* Resampled values per mechanical revolution at the mean speed, must divide
+ * BLOCK_SIZE. The grid step follows the speed, so a block covers a whole
+ * number of revolutions and each order falls onto a bin: order n is bin
+ * n * BLOCK_SIZE / SAMPLES_PER_REV */
+#ifndef HALL_SPECTRUM_SAMPLES_PER_REV
+#define HALL_SPECTRUM_SAMPLES_PER_REV       (32U)
+#endif
+
+/* Mechanical orders reported after every block */
+#ifndef HALL_SPECTRUM_ORDERS
+#define HALL_SPECTRUM_ORDERS                { 1U, 2U, 6U }
+#endif
+#define HALL_SPECTRUM_NUM_ORDERS            (sizeof((const uint8_t[])HALL_SPECTRUM_ORDERS))
+
+/*******************************************************************************
+* Data structure and enumeration
+*******************************************************************************/
+/* Result of one FFT block */
+typedef struct
+{
+    uint32_t block;                                     /* Block counter */
+    uint32_t mean_sector_ticks;                         /* Mean sector time of the block */
+    uint16_t ripple_permille[HALL_SPECTRUM_NUM_ORDERS]; /* Ripple amplitude relative to the mean speed */
+} hall_spectrum_result_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void hall_spectrum_init(void);
+bool hall_spectrum_process(const uint32_t *sector_ticks, uint32_t count);
+void hall_spectrum_get_result(hall_spectrum_result_t *result);
+
+#endif /* HALL_SPECTRUM_H_ */
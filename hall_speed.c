@@ -0,0 +1,369 @@
+/*******************************************************************************
+* File Name:   hall_speed.c
+*
+* Description: Conversion of the captured hall sector time into motor speed.
+*              The division is done with a reciprocal lookup table and one
+*              Newton refinement step, so no software divide is needed on the
+*              Cortex-M0 based XMC1000 devices.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "cybsp.h"
+#include "hall_speed.h"
+#if ENABLE_MATH_COPROCESSOR && defined(MATH)
+#include "xmc_math.h"
+#endif
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Speed in rpm is (60 * 10^9) / (sector_ticks * tick_ns * sectors * pole pairs).
+ * Everything except the sector time is constant and folded into one numerator */
+#define HALL_SPEED_RPM_NUMERATOR            ((uint32_t)(60000000000ULL / \
+                                            ((uint64_t)HALL_SECTORS_PER_PERIOD * \
+                                            HALL_MOTOR_POLE_PAIRS * HALL_SPEED_TIMER_TICK_NS)))
+
+/* Use the MATH coprocessor divider when enabled and present on the device */
+#if ENABLE_MATH_COPROCESSOR && defined(MATH)
+#define HALL_SPEED_USE_MATH_DIV             (1)
+#else
+#define HALL_SPEED_USE_MATH_DIV             (0)
+#endif
+
+/* Number of index bits taken below the leading one of the normalised divisor */
+#define HALL_SPEED_RECIP_INDEX_BITS         (8U)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* Reciprocal seeds: entry i is floor(2^16 / (1 + (i + 1) / 256)), i.e. the
+ * reciprocal of the upper end of the bin, so the seed never overestimates and
+ * the Newton step below stays on the safe side */
+static const uint16_t hall_speed_recip_lut[1U << HALL_SPEED_RECIP_INDEX_BITS] =
+{
+    0xFF00U, 0xFE03U, 0xFD08U, 0xFC0FU, 0xFB18U, 0xFA23U, 0xF92FU, 0xF83EU,
+    0xF74EU, 0xF660U, 0xF574U, 0xF489U, 0xF3A0U, 0xF2B9U, 0xF1D4U, 0xF0F0U,
+    0xF00FU, 0xEF2EU, 0xEE50U, 0xED73U, 0xEC97U, 0xEBBDU, 0xEAE5U, 0xEA0EU,
+    0xE939U, 0xE865U, 0xE793U, 0xE6C2U, 0xE5F3U, 0xE525U, 0xE459U, 0xE38EU,
+    0xE2C4U, 0xE1FCU, 0xE135U, 0xE070U, 0xDFACU, 0xDEE9U, 0xDE27U, 0xDD67U,
+    0xDCA8U, 0xDBEBU, 0xDB2FU, 0xDA74U, 0xD9BAU, 0xD901U, 0xD84AU, 0xD794U,
+    0xD6DFU, 0xD62BU, 0xD578U, 0xD4C7U, 0xD417U, 0xD368U, 0xD2BAU, 0xD20DU,
+    0xD161U, 0xD0B6U, 0xD00DU, 0xCF64U, 0xCEBCU, 0xCE16U, 0xCD71U, 0xCCCCU,
+    0xCC29U, 0xCB87U, 0xCAE5U, 0xCA45U, 0xC9A6U, 0xC907U, 0xC86AU, 0xC7CEU,
+    0xC732U, 0xC698U, 0xC5FEU, 0xC565U, 0xC4CEU, 0xC437U, 0xC3A1U, 0xC30CU,
+    0xC278U, 0xC1E4U, 0xC152U, 0xC0C0U, 0xC030U, 0xBFA0U, 0xBF11U, 0xBE82U,
+    0xBDF5U, 0xBD69U, 0xBCDDU, 0xBC52U, 0xBBC8U, 0xBB3EU, 0xBAB6U, 0xBA2EU,
+    0xB9A7U, 0xB921U, 0xB89BU, 0xB817U, 0xB793U, 0xB70FU, 0xB68DU, 0xB60BU,
+    0xB58AU, 0xB509U, 0xB48AU, 0xB40BU, 0xB38CU, 0xB30FU, 0xB292U, 0xB216U,
+    0xB19AU, 0xB11FU, 0xB0A5U, 0xB02CU, 0xAFB3U, 0xAF3AU, 0xAEC3U, 0xAE4CU,
+    0xADD5U, 0xAD60U, 0xACEBU, 0xAC76U, 0xAC02U, 0xAB8FU, 0xAB1CU, 0xAAAAU,
+    0xAA39U, 0xA9C8U, 0xA957U, 0xA8E8U, 0xA879U, 0xA80AU, 0xA79CU, 0xA72FU,
+    0xA6C2U, 0xA655U, 0xA5E9U, 0xA57EU, 0xA513U, 0xA4A9U, 0xA440U, 0xA3D7U,
+    0xA36EU, 0xA306U, 0xA29EU, 0xA237U, 0xA1D1U, 0xA16BU, 0xA105U, 0xA0A0U,
+    0xA03CU, 0x9FD8U, 0x9F74U, 0x9F11U, 0x9EAEU, 0x9E4CU, 0x9DEBU, 0x9D89U,
+    0x9D29U, 0x9CC8U, 0x9C69U, 0x9C09U, 0x9BAAU, 0x9B4CU, 0x9AEEU, 0x9A90U,
+    0x9A33U, 0x99D7U, 0x997AU, 0x991FU, 0x98C3U, 0x9868U, 0x980EU, 0x97B4U,
+    0x975AU, 0x9701U, 0x96A8U, 0x964FU, 0x95F7U, 0x95A0U, 0x9548U, 0x94F2U,
+    0x949BU, 0x9445U, 0x93EFU, 0x939AU, 0x9345U, 0x92F1U, 0x929CU, 0x9249U,
+    0x91F5U, 0x91A2U, 0x9150U, 0x90FDU, 0x90ABU, 0x905AU, 0x9009U, 0x8FB8U,
+    0x8F67U, 0x8F17U, 0x8EC7U, 0x8E78U, 0x8E29U, 0x8DDAU, 0x8D8BU, 0x8D3DU,
+    0x8CF0U, 0x8CA2U, 0x8C55U, 0x8C08U, 0x8BBCU, 0x8B70U, 0x8B24U, 0x8AD8U,
+    0x8A8DU, 0x8A42U, 0x89F8U, 0x89AEU, 0x8964U, 0x891AU, 0x88D1U, 0x8888U,
+    0x883FU, 0x87F7U, 0x87AFU, 0x8767U, 0x8720U, 0x86D9U, 0x8692U, 0x864BU,
+    0x8605U, 0x85BFU, 0x8579U, 0x8534U, 0x84EEU, 0x84A9U, 0x8465U, 0x8421U,
+    0x83DCU, 0x8399U, 0x8355U, 0x8312U, 0x82CFU, 0x828CU, 0x824AU, 0x8208U,
+    0x81C6U, 0x8184U, 0x8143U, 0x8102U, 0x80C1U, 0x8080U, 0x8040U, 0x8000U,
+};
+
+/*******************************************************************************
+* Function Name: hall_speed_umull
+********************************************************************************
+* Summary:
+*  Multiplies two 32-bit values into a 64-bit product. Cortex-M0 only has a
+*  multiply with a 32-bit result, and a 64-bit product written in C becomes
+*  a call to __aeabi_lmul, so the product is built from four 16 x 16 bit
+*  products instead.
+*
+* Parameters:
+*  a: first factor
+*  b: second factor
+*  low: destination of the lower 32 bits of the product
+*
+* Return:
+*  uint32_t: upper 32 bits of the product
+*
+*******************************************************************************/
+static inline uint32_t hall_speed_umull(uint32_t a, uint32_t b, uint32_t *low)
+{
+    uint32_t ll = (a & 0xFFFFU) * (b & 0xFFFFU);
+    uint32_t lh = (a & 0xFFFFU) * (b >> 16);
+    uint32_t hl = (a >> 16) * (b & 0xFFFFU);
+    uint32_t hh = (a >> 16) * (b >> 16);
+    uint32_t mid = (ll >> 16) + (lh & 0xFFFFU) + (hl & 0xFFFFU);
+
+    *low = (mid << 16) | (ll & 0xFFFFU);
+
+    return hh + (lh >> 16) + (hl >> 16) + (mid >> 16);
+}
+
+/*******************************************************************************
+* Function Name: hall_speed_recip
+********************************************************************************
+* Summary:
+*  Approximates 2^63 / m for a normalised divisor m (bit 31 set). The table
+*  seed has about 8 bits of precision and one Newton step doubles it. The
+*  result never exceeds the exact reciprocal.
+*
+* Parameters:
+*  m: normalised divisor
+*
+* Return:
+*  uint32_t: reciprocal estimate
+*
+*******************************************************************************/
+static uint32_t hall_speed_recip(uint32_t m)
+{
+    uint32_t r0;
+    uint32_t high;
+    uint32_t low;
+    uint32_t err;
+
+    r0 = (uint32_t)hall_speed_recip_lut[(m >> (31U - HALL_SPEED_RECIP_INDEX_BITS)) &
+                                        ((1U << HALL_SPEED_RECIP_INDEX_BITS) - 1U)] << 16;
+
+    /* Newton step r1 = r0 * (2 - m * r0 / 2^63). err is the upper word of
+     * 2^63 - m * r0, which is not negative as the seed is never too large */
+    high = hall_speed_umull(m, r0, &low);
+    err = 0x80000000U - high - ((low != 0U) ? 1U : 0U);
+
+    high = hall_speed_umull(r0, err, &low);
+
+    return r0 + ((high << 1) | (low >> 31));
+}
+
+/*******************************************************************************
+* Function Name: hall_speed_udiv_reciprocal
+********************************************************************************
+* Summary:
+*  Unsigned 32-bit division without a divide instruction. The quotient is
+*  obtained by multiplying with a reciprocal estimate, refined once with the
+*  remainder and finally corrected by at most a few subtractions, so the
+*  result is the exact floor(dividend / divisor) for the full 32-bit range.
+*
+* Parameters:
+*  dividend: value to divide
+*  divisor: value to divide by, must not be zero
+*
+* Return:
+*  uint32_t: dividend / divisor, rounded down
+*
+*******************************************************************************/
+uint32_t hall_speed_udiv_reciprocal(uint32_t dividend, uint32_t divisor)
+{
+    uint32_t shift = 0U;
+    uint32_t m = divisor;
+    uint32_t recip;
+    uint32_t quotient;
+    uint32_t remainder;
+    uint32_t low;
+
+    /* Normalise the divisor. Cortex-M0 has no CLZ instruction */
+    if ((m & 0xFFFF0000U) == 0U) { m <<= 16; shift += 16U; }
+    if ((m & 0xFF000000U) == 0U) { m <<= 8;  shift += 8U;  }
+    if ((m & 0xF0000000U) == 0U) { m <<= 4;  shift += 4U;  }
+    if ((m & 0xC0000000U) == 0U) { m <<= 2;  shift += 2U;  }
+    if ((m & 0x80000000U) == 0U) { m <<= 1;  shift += 1U;  }
+
+    recip = hall_speed_recip(m);
+
+    /* dividend / divisor = dividend * 2^shift * recip / 2^63, i.e. the upper
+     * word of dividend * recip shifted right by 31 - shift */
+    quotient = hall_speed_umull(dividend, recip, &low) >> (31U - shift);
+
+    /* The estimate is low by a small fraction; refine it with the remainder */
+    remainder = dividend - (quotient * divisor);
+    quotient += hall_speed_umull(remainder, recip, &low) >> (31U - shift);
+
+    /* The quotient is now at most a few counts low */
+    remainder = dividend - (quotient * divisor);
+    while (remainder >= divisor)
+    {
+        remainder -= divisor;
+        quotient++;
+    }
+
+    return quotient;
+}
+
+#if !HALL_SPEED_USE_MATH_DIV
+/* Speed of the last sector started with hall_speed_start_rpm() */
+static uint32_t hall_speed_pending_rpm = 0U;
+#endif
+
+/*******************************************************************************
+* Function Name: hall_speed_init
+********************************************************************************
+* Summary:
+*  Enables the clock of the MATH coprocessor when the coprocessor backend is
+*  selected. Does nothing for the software backend.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_speed_init(void)
+{
+#if HALL_SPEED_USE_MATH_DIV && defined(CLOCK_GATING_SUPPORTED)
+    XMC_SCU_CLOCK_UngatePeripheralClock(XMC_SCU_PERIPHERAL_CLOCK_MATH);
+#endif
+}
+
+/*******************************************************************************
+* Function Name: hall_speed_udiv
+********************************************************************************
+* Summary:
+*  Unsigned 32-bit division. Uses the MATH coprocessor divider when that
+*  backend is selected, hall_speed_udiv_reciprocal() with
+*  ENABLE_RECIPROCAL_DIV, and the compiler's division otherwise: the divide
+*  instruction on XMC4000 devices and the library routine on XMC1000.
+*
+* Parameters:
+*  dividend: value to divide
+*  divisor: value to divide by, must not be zero
+*
+* Return:
+*  uint32_t: dividend / divisor, rounded down
+*
+*******************************************************************************/
+uint32_t hall_speed_udiv(uint32_t dividend, uint32_t divisor)
+{
+#if HALL_SPEED_USE_MATH_DIV
+    uint32_t primask = __get_PRIMASK();
+    uint32_t quotient;
+
+    /* The divider is shared with the CHE interrupt; keep the operation atomic */
+    __disable_irq();
+    quotient = XMC_MATH_DIV_UnsignedDiv(dividend, divisor);
+    __set_PRIMASK(primask);
+
+    return quotient;
+#elif ENABLE_RECIPROCAL_DIV
+    return hall_speed_udiv_reciprocal(dividend, divisor);
+#else
+    return dividend / divisor;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: hall_speed_get_rpm
+********************************************************************************
+* Summary:
+*  Converts the speed timer ticks captured between two correct hall events
+*  into the mechanical speed of the motor.
+*
+* Parameters:
+*  sector_ticks: captured speed timer value of one hall sector
+*
+* Return:
+*  uint32_t: speed in rpm, 0 if no sector time is available
+*
+*******************************************************************************/
+uint32_t hall_speed_get_rpm(uint32_t sector_ticks)
+{
+    if (sector_ticks == 0U)
+    {
+        return 0U;
+    }
+
+    return hall_speed_udiv(HALL_SPEED_RPM_NUMERATOR, sector_ticks);
+}
+
+/*******************************************************************************
+* Function Name: hall_speed_start_rpm
+********************************************************************************
+* Summary:
+*  Starts the speed conversion of one sector time. With the MATH coprocessor
+*  backend the division runs in the background and the CPU can do other work
+*  until hall_speed_read_rpm() is called. The software backend computes the
+*  result immediately.
+*
+* Parameters:
+*  sector_ticks: captured speed timer value of one hall sector
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_speed_start_rpm(uint32_t sector_ticks)
+{
+#if HALL_SPEED_USE_MATH_DIV
+    /* A zero divisor yields 0 from hall_speed_get_rpm(); divide zero by one */
+    if (sector_ticks == 0U)
+    {
+        XMC_MATH_DIV_UnsignedDivNB(0U, 1U);
+    }
+    else
+    {
+        XMC_MATH_DIV_UnsignedDivNB(HALL_SPEED_RPM_NUMERATOR, sector_ticks);
+    }
+#else
+    hall_speed_pending_rpm = hall_speed_get_rpm(sector_ticks);
+#endif
+}
+
+/*******************************************************************************
+* Function Name: hall_speed_read_rpm
+********************************************************************************
+* Summary:
+*  Returns the speed of the conversion started with hall_speed_start_rpm().
+*  With the MATH coprocessor backend the read stalls until the divider is
+*  done, which takes at most 35 MATH clock cycles.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t: speed in rpm
+*
+*******************************************************************************/
+uint32_t hall_speed_read_rpm(void)
+{
+#if HALL_SPEED_USE_MATH_DIV
+    return XMC_MATH_DIV_GetUnsignedDivResult();
+#else
+    return hall_speed_pending_rpm;
+#endif
+}
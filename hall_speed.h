@@ -0,0 +1,67 @@
+/*******************************************************************************
+* File Name:   hall_speed.h
+*
+* Description: Conversion of the captured hall sector time into motor speed.
+*              The division is done with a reciprocal lookup table and one
+*              Newton refinement step, so no software divide is needed on the
+*              Cortex-M0 based XMC1000 devices.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#ifndef HALL_SPEED_H_
+#define HALL_SPEED_H_
+
+#include <stdint.h>
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Number of motor pole pairs. One electrical period spans six hall sectors */
+#ifndef HALL_MOTOR_POLE_PAIRS
+#define HALL_MOTOR_POLE_PAIRS               (1U)
+#endif
+
+/* Number of hall sectors per electrical period */
+#define HALL_SECTORS_PER_PERIOD             (6U)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void hall_speed_init(void);
+uint32_t hall_speed_udiv(uint32_t dividend, uint32_t divisor);
+uint32_t hall_speed_udiv_reciprocal(uint32_t dividend, uint32_t divisor);
+uint32_t hall_speed_get_rpm(uint32_t sector_ticks);
+void hall_speed_start_rpm(uint32_t sector_ticks);
+uint32_t hall_speed_read_rpm(void);
+
+#endif /* HALL_SPEED_H_ */
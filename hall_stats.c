@@ -0,0 +1,275 @@
+/*******************************************************************************
+* File Name:   hall_stats.c
+*
+* Description: Running statistics of the sector time and speed per report window.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "cybsp.h"
+#include "hall_stats.h"
+
+/*******************************************************************************
+* Data structure and enumeration
+*******************************************************************************/
+/* Moments of the values relative to the first value of the window. In
+ * integers the sums are exact, so the variance does not suffer from the
+ * cancellation that makes plain sums unusable in floating point, and no
+ * division per value is needed as in the Welford update */
+typedef struct
+{
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint32_t shift;         /* First value of the window */
+    int64_t sum;            /* Sum of (value - shift) */
+    uint64_t sum_squares;   /* Sum of (value - shift)^2 */
+} hall_stats_acc_t;
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static hall_stats_acc_t hall_stats_sector;
+static hall_stats_acc_t hall_stats_speed;
+
+/* Number of interpolated sector times in the report window */
+static uint32_t hall_stats_interpolated;
+
+/*******************************************************************************
+* Function Name: hall_stats_add
+********************************************************************************
+* Summary:
+*  Adds a value to an accumulator.
+*
+* Parameters:
+*  acc: accumulator
+*  value: new value
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void hall_stats_add(hall_stats_acc_t *acc, uint32_t value)
+{
+    int32_t deviation;
+
+    if (acc->count++ == 0U)
+    {
+        acc->min = value;
+        acc->max = value;
+        acc->shift = value;
+        acc->sum = 0;
+        acc->sum_squares = 0U;
+        return;
+    }
+
+    if (value < acc->min)
+    {
+        acc->min = value;
+    }
+    if (value > acc->max)
+    {
+        acc->max = value;
+    }
+
+    deviation = (int32_t)(value - acc->shift);
+    acc->sum += deviation;
+    acc->sum_squares += (uint64_t)((int64_t)deviation * deviation);
+}
+
+/*******************************************************************************
+* Function Name: hall_stats_sqrt
+********************************************************************************
+* Summary:
+*  Integer square root.
+*
+* Parameters:
+*  value: radicand
+*
+* Return:
+*  uint32_t: square root, rounded down
+*
+*******************************************************************************/
+static uint32_t hall_stats_sqrt(uint64_t value)
+{
+    uint64_t root = 0U;
+    uint64_t bit = 1ULL << 62;
+
+    while (bit > value)
+    {
+        bit >>= 2;
+    }
+
+    while (bit != 0U)
+    {
+        if (value >= (root + bit))
+        {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return (uint32_t)root;
+}
+
+/*******************************************************************************
+* Function Name: hall_stats_result
+********************************************************************************
+* Summary:
+*  Derives the statistics of an accumulator.
+*
+* Parameters:
+*  acc: accumulator
+*  stats: destination of the statistics
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void hall_stats_result(const hall_stats_acc_t *acc, hall_stats_t *stats)
+{
+    int64_t sum = acc->sum * (1 << HALL_STATS_FRAC_BITS);
+    uint64_t squares;
+    uint64_t sum_magnitude;
+
+    stats->count = acc->count;
+    if (acc->count == 0U)
+    {
+        stats->min = 0U;
+        stats->max = 0U;
+        stats->mean = 0U;
+        stats->stddev = 0U;
+        return;
+    }
+
+    stats->min = acc->min;
+    stats->max = acc->max;
+
+    /* mean = shift + sum / n, rounded */
+    sum_magnitude = (uint64_t)((sum >= 0) ? sum : -sum) + (acc->count >> 1);
+    sum_magnitude /= acc->count;
+    stats->mean = (acc->shift << HALL_STATS_FRAC_BITS) +
+                  (uint32_t)((sum >= 0) ? (int64_t)sum_magnitude : -(int64_t)sum_magnitude);
+
+    /* variance = (sum_squares - sum^2 / n) / (n - 1). sum^2 / n is split as
+     * sum * (sum / n) + sum * (sum % n) / n so that it cannot overflow */
+    stats->stddev = 0U;
+    if (acc->count > 1U)
+    {
+        uint64_t magnitude = (uint64_t)((acc->sum >= 0) ? acc->sum : -acc->sum);
+        uint64_t partial = magnitude * (magnitude % acc->count);
+
+        squares = acc->sum_squares - (magnitude * (magnitude / acc->count)) - (partial / acc->count);
+        if (squares < (1ULL << (63U - (2U * HALL_STATS_FRAC_BITS))))
+        {
+            squares = (squares << (2U * HALL_STATS_FRAC_BITS)) -
+                      (((partial % acc->count) << (2U * HALL_STATS_FRAC_BITS)) / acc->count);
+            stats->stddev = hall_stats_sqrt(squares / (acc->count - 1U));
+        }
+        else
+        {
+            stats->stddev = hall_stats_sqrt(squares / (acc->count - 1U)) << HALL_STATS_FRAC_BITS;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: hall_stats_update
+********************************************************************************
+* Summary:
+*  Adds the sector time and speed of a correct hall event to the statistics
+*  of the current report window. Called from the correct hall event
+*  interrupt.
+*
+* Parameters:
+*  sector_ticks: sector time in speed timer ticks
+*  rpm: speed in rpm
+*  interpolated: true if the sector time was interpolated across a missed
+*                hall edge instead of captured
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_stats_update(uint32_t sector_ticks, uint32_t rpm, bool interpolated)
+{
+    if (interpolated)
+    {
+        hall_stats_interpolated++;
+    }
+    hall_stats_add(&hall_stats_sector, sector_ticks);
+    hall_stats_add(&hall_stats_speed, rpm);
+}
+
+/*******************************************************************************
+* Function Name: hall_stats_snapshot
+********************************************************************************
+* Summary:
+*  Returns the statistics of the report window and starts a new window. The
+*  accumulators are copied and cleared with interrupts disabled, so both
+*  results cover the same set of hall events.
+*
+* Parameters:
+*  sector: destination of the sector time statistics in speed timer ticks
+*  speed: destination of the speed statistics in rpm
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_stats_snapshot(hall_stats_t *sector, hall_stats_t *speed)
+{
+    hall_stats_acc_t sector_acc;
+    hall_stats_acc_t speed_acc;
+    uint32_t interpolated;
+    uint32_t primask;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    sector_acc = hall_stats_sector;
+    speed_acc = hall_stats_speed;
+    interpolated = hall_stats_interpolated;
+    hall_stats_sector.count = 0U;
+    hall_stats_speed.count = 0U;
+    hall_stats_interpolated = 0U;
+    __set_PRIMASK(primask);
+
+    hall_stats_result(&sector_acc, sector);
+    hall_stats_result(&speed_acc, speed);
+    sector->interpolated = interpolated;
+    speed->interpolated = interpolated;
+}
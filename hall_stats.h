@@ -0,0 +1,69 @@
+/*******************************************************************************
+* File Name:   hall_stats.h
+*
+* Description: Running statistics of the sector time and speed per report window.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#ifndef HALL_STATS_H_
+#define HALL_STATS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Fractional bits of the mean and standard deviation */
+#define HALL_STATS_FRAC_BITS                (8U)
+
+/*******************************************************************************
+* Data structure and enumeration
+*******************************************************************************/
+typedef struct
+{
+    uint32_t count;         /* Number of values */
+    uint32_t interpolated;  /* Values of sector times interpolated across a missed hall edge */
+    uint32_t min;
+    uint32_t max;
+    uint32_t mean;          /* HALL_STATS_FRAC_BITS fractional bits */
+    uint32_t stddev;        /* Sample standard deviation, HALL_STATS_FRAC_BITS fractional bits */
+} hall_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void hall_stats_update(uint32_t sector_ticks, uint32_t rpm, bool interpolated);
+void hall_stats_snapshot(hall_stats_t *sector, hall_stats_t *speed);
+
+#endif /* HALL_STATS_H_ */
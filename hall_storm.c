@@ -0,0 +1,293 @@
+/*******************************************************************************
+* File Name:   hall_storm.c
+*
+* Description: Rate limiting of the wrong hall event interrupt during event storms.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "cybsp.h"
+#include "hall_storm.h"
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Tokens are counted in thousandths of an event, so that the bucket can be
+ * refilled by HALL_STORM_RATE every millisecond */
+#define HALL_STORM_TOKEN                    (1000U)
+#define HALL_STORM_CAPACITY                 (HALL_STORM_BURST * HALL_STORM_TOKEN)
+
+/* While the interrupt is masked, the wrong hall events are counted by CCU40
+ * slice 2 from POSIF0.OUT2 where the device connects them. Otherwise the
+ * event flag is polled, which sees at most one event per millisecond */
+#if defined(CCU40_IN2_POSIF0_OUT2)
+#define HALL_STORM_COUNTER_HW               (CCU40_CC42)
+#define HALL_STORM_COUNTER_SLICE            (2U)
+#define HALL_STORM_COUNTER_INPUT            (CCU40_IN2_POSIF0_OUT2)
+#define HALL_STORM_COUNTER_SHADOW_TRANSFER  (XMC_CCU4_SHADOW_TRANSFER_SLICE_2)
+#elif ENABLE_WHE_STORM_LIMIT
+#warning "POSIF0.OUT2 is not connected to CCU40 slice 2, masked wrong hall events are polled"
+#endif
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* Token bucket fill level */
+static volatile uint32_t hall_storm_tokens = HALL_STORM_CAPACITY;
+
+/* Remaining milliseconds until the interrupt is unmasked, 0 if not masked */
+static volatile uint32_t hall_storm_cooldown = 0U;
+
+static hall_storm_stats_t hall_storm_stats;
+
+#ifdef HALL_STORM_COUNTER_HW
+/* Event counter value at the last poll */
+static uint16_t hall_storm_count = 0U;
+
+/* Event counter: counts the rising edges of POSIF0.OUT2 up to the period */
+static const XMC_CCU4_SLICE_COMPARE_CONFIG_t hall_storm_counter_config =
+{
+    .timer_mode = (uint32_t)XMC_CCU4_SLICE_TIMER_COUNT_MODE_EA,
+    .monoshot = (uint32_t)XMC_CCU4_SLICE_TIMER_REPEAT_MODE_REPEAT,
+    .shadow_xfer_clear = 0U,
+    .dither_timer_period = 0U,
+    .dither_duty_cycle = 0U,
+    .prescaler_mode = (uint32_t)XMC_CCU4_SLICE_PRESCALER_MODE_NORMAL,
+    .mcm_enable = 0U,
+    .prescaler_initval = 0U,
+    .float_limit = 0U,
+    .dither_limit = 0U,
+    .passive_level = (uint32_t)XMC_CCU4_SLICE_OUTPUT_PASSIVE_LEVEL_LOW,
+    .timer_concatenation = 0U
+};
+
+static const XMC_CCU4_SLICE_EVENT_CONFIG_t hall_storm_event_config =
+{
+    .mapped_input = HALL_STORM_COUNTER_INPUT,
+    .edge = XMC_CCU4_SLICE_EVENT_EDGE_SENSITIVITY_RISING_EDGE,
+    .level = XMC_CCU4_SLICE_EVENT_LEVEL_SENSITIVITY_ACTIVE_HIGH,
+    .duration = XMC_CCU4_SLICE_EVENT_FILTER_DISABLED
+};
+#endif
+
+/*******************************************************************************
+* Function Name: hall_storm_init
+********************************************************************************
+* Summary:
+*  Resets the rate limit and starts the wrong hall event counter, if the
+*  device connects POSIF0.OUT2 to it. Called once before the POSIF starts.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_storm_init(void)
+{
+    hall_storm_reset();
+
+#ifdef HALL_STORM_COUNTER_HW
+    XMC_CCU4_SLICE_CompareInit(HALL_STORM_COUNTER_HW, &hall_storm_counter_config);
+    XMC_CCU4_SLICE_SetTimerPeriodMatch(HALL_STORM_COUNTER_HW, 0xFFFFU);
+    XMC_CCU4_SLICE_ConfigureEvent(HALL_STORM_COUNTER_HW, XMC_CCU4_SLICE_EVENT_0, &hall_storm_event_config);
+    XMC_CCU4_SLICE_CountConfig(HALL_STORM_COUNTER_HW, XMC_CCU4_SLICE_EVENT_0);
+    XMC_CCU4_EnableShadowTransfer(CCU40, HALL_STORM_COUNTER_SHADOW_TRANSFER);
+    XMC_CCU4_EnableClock(CCU40, HALL_STORM_COUNTER_SLICE);
+    XMC_CCU4_SLICE_StartTimer(HALL_STORM_COUNTER_HW);
+#endif
+}
+
+/*******************************************************************************
+* Function Name: hall_storm_reset
+********************************************************************************
+* Summary:
+*  Fills the token bucket and clears the statistics.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_storm_reset(void)
+{
+    hall_storm_tokens = HALL_STORM_CAPACITY;
+    hall_storm_cooldown = 0U;
+    hall_storm_stats.storms = 0U;
+    hall_storm_stats.suppressed = 0U;
+}
+
+/*******************************************************************************
+* Function Name: hall_storm_event
+********************************************************************************
+* Summary:
+*  Takes a token for a wrong hall event. Called from the wrong hall event
+*  interrupt. When the bucket is empty, the storm starts and the caller masks
+*  the interrupt for HALL_STORM_COOLDOWN_MS.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  bool: false if the interrupt must be masked
+*
+*******************************************************************************/
+bool hall_storm_event(void)
+{
+    if (hall_storm_tokens >= HALL_STORM_TOKEN)
+    {
+        hall_storm_tokens -= HALL_STORM_TOKEN;
+    }
+
+    if (hall_storm_tokens < HALL_STORM_TOKEN)
+    {
+        hall_storm_cooldown = HALL_STORM_COOLDOWN_MS;
+        hall_storm_stats.storms++;
+        #ifdef HALL_STORM_COUNTER_HW
+        /* Events from here on are counted while masked */
+        hall_storm_count = (uint16_t)XMC_CCU4_SLICE_GetTimerValue(HALL_STORM_COUNTER_HW);
+        #endif
+        return false;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: hall_storm_poll
+********************************************************************************
+* Summary:
+*  Returns the wrong hall events since the last poll, while the interrupt is
+*  masked. They are read from the event counter, or, without it, from the
+*  event flag, which is cleared. Called every millisecond during the cooldown.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t: number of wrong hall events
+*
+*******************************************************************************/
+uint32_t hall_storm_poll(void)
+{
+#ifdef HALL_STORM_COUNTER_HW
+    uint16_t count = (uint16_t)XMC_CCU4_SLICE_GetTimerValue(HALL_STORM_COUNTER_HW);
+    uint32_t events = (uint16_t)(count - hall_storm_count);
+
+    hall_storm_count = count;
+
+    return events;
+#else
+    if (!XMC_POSIF_GetEventStatus(HALL_POSIF_HW, XMC_POSIF_IRQ_EVENT_WHE))
+    {
+        return 0U;
+    }
+    XMC_POSIF_ClearEvent(HALL_POSIF_HW, XMC_POSIF_IRQ_EVENT_WHE);
+
+    return 1U;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: hall_storm_tick
+********************************************************************************
+* Summary:
+*  Refills the token bucket and runs the cooldown. Called every millisecond.
+*
+* Parameters:
+*  events: wrong hall events polled while masked
+*
+* Return:
+*  bool: true if the cooldown expired and the interrupt must be unmasked
+*
+*******************************************************************************/
+bool hall_storm_tick(uint32_t events)
+{
+    uint32_t primask;
+    uint32_t tokens;
+
+    /* The wrong hall event interrupt takes tokens meanwhile */
+    primask = __get_PRIMASK();
+    __disable_irq();
+    tokens = hall_storm_tokens + HALL_STORM_RATE;
+    hall_storm_tokens = (tokens < HALL_STORM_CAPACITY) ? tokens : HALL_STORM_CAPACITY;
+    __set_PRIMASK(primask);
+
+    if (hall_storm_cooldown == 0U)
+    {
+        return false;
+    }
+
+    hall_storm_stats.suppressed += events;
+
+    return (--hall_storm_cooldown == 0U);
+}
+
+/*******************************************************************************
+* Function Name: hall_storm_is_active
+********************************************************************************
+* Summary:
+*  Returns whether the wrong hall event interrupt is masked.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  bool: true during the cooldown
+*
+*******************************************************************************/
+bool hall_storm_is_active(void)
+{
+    return (hall_storm_cooldown != 0U);
+}
+
+/*******************************************************************************
+* Function Name: hall_storm_get_stats
+********************************************************************************
+* Summary:
+*  Returns the storm statistics.
+*
+* Parameters:
+*  stats: destination of the statistics
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_storm_get_stats(hall_storm_stats_t *stats)
+{
+    *stats = hall_storm_stats;
+    stats->active = hall_storm_is_active();
+}
@@ -0,0 +1,83 @@
+/*******************************************************************************
+* File Name:   hall_storm.h
+*
+* Description: Rate limiting of the wrong hall event interrupt during event storms.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#ifndef HALL_STORM_H_
+#define HALL_STORM_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Wrong hall events accepted in a burst */
+#ifndef HALL_STORM_BURST
+#define HALL_STORM_BURST                    (16U)
+#endif
+
+/* Sustained wrong hall event rate accepted, in events per second */
+#ifndef HALL_STORM_RATE
+#define HALL_STORM_RATE                     (100U)
+#endif
+
+/* Time the interrupt stays masked after the limit was hit, in milliseconds */
+#ifndef HALL_STORM_COOLDOWN_MS
+#define HALL_STORM_COOLDOWN_MS              (100U)
+#endif
+
+/*******************************************************************************
+* Data structure and enumeration
+*******************************************************************************/
+typedef struct
+{
+    uint32_t storms;        /* Times the interrupt was masked */
+    uint32_t suppressed;    /* Wrong hall events while masked */
+    bool active;            /* Interrupt currently masked */
+} hall_storm_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void hall_storm_init(void);
+void hall_storm_reset(void);
+bool hall_storm_event(void);
+uint32_t hall_storm_poll(void);
+bool hall_storm_tick(uint32_t events);
+bool hall_storm_is_active(void);
+void hall_storm_get_stats(hall_storm_stats_t *stats);
+
+#endif /* HALL_STORM_H_ */
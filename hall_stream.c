@@ -0,0 +1,420 @@
+/*******************************************************************************
+* File Name:   hall_stream.c
+*
+* Description: Delta-encoded stream of the hall sector times.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "cybsp.h"
+#include "hall_stream.h"
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+#define HALL_STREAM_BUFFER_MASK             (HALL_STREAM_BUFFER_SIZE - 1U)
+
+#if (HALL_STREAM_BUFFER_SIZE & HALL_STREAM_BUFFER_MASK) != 0U
+#error "HALL_STREAM_BUFFER_SIZE must be a power of two"
+#endif
+
+/* Keyframes are the longest records, a delta takes at most five bytes; both
+ * can be prefixed by the interpolation marker */
+#define HALL_STREAM_MAX_RECORD              (HALL_STREAM_KEYFRAME_LENGTH + 1U)
+
+/* Bytes per value of a keyframe */
+#define HALL_STREAM_KEYFRAME_FIELD          (5U)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* Stream bytes, written by the hall event interrupts and read by a single
+ * consumer. The free running indices are wrapped with the mask on access */
+static uint8_t hall_stream_data[HALL_STREAM_BUFFER_SIZE];
+static volatile uint32_t hall_stream_head = 0U;
+static volatile uint32_t hall_stream_tail = 0U;
+
+/* Sector time the next delta is relative to */
+static uint32_t hall_stream_prediction = 0U;
+
+/* Deltas since the last keyframe; a keyframe is forced when the interval is
+ * reached or after a record was dropped */
+static uint32_t hall_stream_deltas = HALL_STREAM_KEYFRAME_INTERVAL;
+
+static hall_stream_stats_t hall_stream_stats;
+
+/* Time base of the keyframes */
+static volatile uint32_t hall_stream_time_ms = 0U;
+
+/*******************************************************************************
+* Function Name: hall_stream_encode_field
+********************************************************************************
+* Summary:
+*  Encodes a keyframe value in five bytes of seven bits with bit 7 set.
+*
+* Parameters:
+*  record: destination of HALL_STREAM_KEYFRAME_FIELD bytes
+*  value: value to encode
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void hall_stream_encode_field(uint8_t *record, uint32_t value)
+{
+    uint32_t i;
+
+    for (i = 0U; i < HALL_STREAM_KEYFRAME_FIELD; i++)
+    {
+        record[i] = (uint8_t)(value | 0x80U);
+        value >>= 7;
+    }
+}
+
+/*******************************************************************************
+* Function Name: hall_stream_encode_keyframe
+********************************************************************************
+* Summary:
+*  Encodes a sector time as keyframe together with the current time, so that
+*  a reader can seek to a time by the keyframes alone.
+*
+* Parameters:
+*  record: destination of HALL_STREAM_KEYFRAME_LENGTH bytes
+*  sector_ticks: sector time in speed timer ticks
+*
+* Return:
+*  uint32_t: number of bytes written
+*
+*******************************************************************************/
+static uint32_t hall_stream_encode_keyframe(uint8_t *record, uint32_t sector_ticks)
+{
+    record[0] = HALL_STREAM_KEYFRAME;
+    hall_stream_encode_field(&record[1], sector_ticks);
+    hall_stream_encode_field(&record[1U + HALL_STREAM_KEYFRAME_FIELD], hall_stream_time_ms);
+
+    return HALL_STREAM_KEYFRAME_LENGTH;
+}
+
+/*******************************************************************************
+* Function Name: hall_stream_encode_delta
+********************************************************************************
+* Summary:
+*  Encodes the zig-zag mapped delta plus HALL_STREAM_DELTA_OFFSET as varint:
+*  seven bits per byte, least significant first, bit 7 set on all but the
+*  last byte. The offset keeps the markers out of the deltas, so deltas of
+*  -62 to +62 ticks take a single byte.
+*
+* Parameters:
+*  record: destination of up to five bytes
+*  zigzag: zig-zag mapped delta, at most 0xFFFFFFFF - HALL_STREAM_DELTA_OFFSET
+*
+* Return:
+*  uint32_t: number of bytes written
+*
+*******************************************************************************/
+static uint32_t hall_stream_encode_delta(uint8_t *record, uint32_t zigzag)
+{
+    uint32_t value = zigzag + HALL_STREAM_DELTA_OFFSET;
+    uint32_t length = 0U;
+
+    while (value >= 0x80U)
+    {
+        record[length++] = (uint8_t)(value | 0x80U);
+        value >>= 7;
+    }
+    record[length++] = (uint8_t)value;
+
+    return length;
+}
+
+/*******************************************************************************
+* Function Name: hall_stream_write
+********************************************************************************
+* Summary:
+*  Adds a record to the buffer as a whole. Runs with interrupts disabled, as
+*  the correct hall event interrupt can preempt the wrong hall event one.
+*
+* Parameters:
+*  record: encoded record
+*  length: number of bytes of the record
+*
+* Return:
+*  bool: false if the buffer was full and the record was dropped
+*
+*******************************************************************************/
+static bool hall_stream_write(const uint8_t *record, uint32_t length)
+{
+    uint32_t primask = __get_PRIMASK();
+    uint32_t head;
+    uint32_t i;
+
+    __disable_irq();
+    head = hall_stream_head;
+    if ((HALL_STREAM_BUFFER_SIZE - (head - hall_stream_tail)) < length)
+    {
+        hall_stream_stats.dropped++;
+        __set_PRIMASK(primask);
+        return false;
+    }
+
+    for (i = 0U; i < length; i++)
+    {
+        hall_stream_data[(head + i) & HALL_STREAM_BUFFER_MASK] = record[i];
+    }
+    hall_stream_head = head + length;
+    hall_stream_stats.bytes += length;
+    __set_PRIMASK(primask);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: hall_stream_reset
+********************************************************************************
+* Summary:
+*  Discards the buffered bytes and the statistics. The next sector time is
+*  sent as keyframe.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_stream_reset(void)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    hall_stream_tail = hall_stream_head;
+    hall_stream_prediction = 0U;
+    hall_stream_deltas = HALL_STREAM_KEYFRAME_INTERVAL;
+    hall_stream_stats.edges = 0U;
+    hall_stream_stats.interpolated = 0U;
+    hall_stream_stats.bytes = 0U;
+    hall_stream_stats.keyframes = 0U;
+    hall_stream_stats.wrong_events = 0U;
+    hall_stream_stats.dropped = 0U;
+    __set_PRIMASK(primask);
+}
+
+/*******************************************************************************
+* Function Name: hall_stream_tick
+********************************************************************************
+* Summary:
+*  Advances the keyframe time base. Must be called from the SysTick handler.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_stream_tick(void)
+{
+    hall_stream_time_ms++;
+}
+
+/*******************************************************************************
+* Function Name: hall_stream_push
+********************************************************************************
+* Summary:
+*  Encodes one sector time relative to the previous one and adds it to the
+*  buffer. A record that does not fit is dropped as a whole and the next
+*  sector time is sent as keyframe. Must only be called from the context
+*  that processes the sector times.
+*
+* Parameters:
+*  sector_ticks: captured speed timer value of one hall sector
+*  interpolated: true if the sector time was interpolated across a missed
+*                hall edge instead of captured
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_stream_push(uint32_t sector_ticks, bool interpolated)
+{
+    uint8_t record[HALL_STREAM_MAX_RECORD];
+    int32_t delta = (int32_t)(sector_ticks - hall_stream_prediction);
+    uint32_t zigzag = (delta < 0) ? ~((uint32_t)delta << 1) : ((uint32_t)delta << 1);
+    uint32_t prefix = 0U;
+    uint32_t length;
+
+    hall_stream_stats.edges++;
+
+    if (interpolated)
+    {
+        record[prefix++] = HALL_STREAM_INTERPOLATED;
+    }
+
+    /* The largest deltas have no varint encoding either */
+    if ((hall_stream_deltas >= HALL_STREAM_KEYFRAME_INTERVAL) || (zigzag > (UINT32_MAX - HALL_STREAM_DELTA_OFFSET)))
+    {
+        length = prefix + hall_stream_encode_keyframe(&record[prefix], sector_ticks);
+    }
+    else
+    {
+        length = prefix + hall_stream_encode_delta(&record[prefix], zigzag);
+    }
+
+    if (!hall_stream_write(record, length))
+    {
+        hall_stream_deltas = HALL_STREAM_KEYFRAME_INTERVAL;
+        return;
+    }
+
+    if (interpolated)
+    {
+        hall_stream_stats.interpolated++;
+    }
+    if (record[prefix] == HALL_STREAM_KEYFRAME)
+    {
+        hall_stream_stats.keyframes++;
+        hall_stream_deltas = 0U;
+    }
+    else
+    {
+        hall_stream_deltas++;
+    }
+    hall_stream_prediction = sector_ticks;
+}
+
+/*******************************************************************************
+* Function Name: hall_stream_push_whe
+********************************************************************************
+* Summary:
+*  Adds a wrong hall event marker to the stream. The marker does not change
+*  the prediction of the next sector time.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_stream_push_whe(void)
+{
+    static const uint8_t record = HALL_STREAM_WHE;
+
+    hall_stream_stats.wrong_events++;
+    (void)hall_stream_write(&record, 1U);
+}
+
+/*******************************************************************************
+* Function Name: hall_stream_start_chunk
+********************************************************************************
+* Summary:
+*  Ends the current chunk and sends the next sector time as keyframe, so that
+*  the bytes after the returned count can be decoded and placed in time
+*  without the ones before. Both happen with interrupts disabled, so no edge
+*  can be encoded as delta between the end of a chunk and its keyframe.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t: number of buffered bytes that belong to the ended chunk
+*
+*******************************************************************************/
+uint32_t hall_stream_start_chunk(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    uint32_t count;
+
+    __disable_irq();
+    hall_stream_deltas = HALL_STREAM_KEYFRAME_INTERVAL;
+    count = hall_stream_head - hall_stream_tail;
+    __set_PRIMASK(primask);
+
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: hall_stream_read
+********************************************************************************
+* Summary:
+*  Copies the oldest buffered stream bytes and removes them from the buffer.
+*  Must only be called from one context.
+*
+* Parameters:
+*  data: destination of the stream bytes
+*  max_count: size of the destination
+*
+* Return:
+*  uint32_t: number of bytes copied
+*
+*******************************************************************************/
+uint32_t hall_stream_read(uint8_t *data, uint32_t max_count)
+{
+    uint32_t tail = hall_stream_tail;
+    uint32_t count = hall_stream_head - tail;
+    uint32_t i;
+
+    if (count > max_count)
+    {
+        count = max_count;
+    }
+
+    for (i = 0U; i < count; i++)
+    {
+        data[i] = hall_stream_data[(tail + i) & HALL_STREAM_BUFFER_MASK];
+    }
+    hall_stream_tail = tail + count;
+
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: hall_stream_get_stats
+********************************************************************************
+* Summary:
+*  Returns the encoder statistics.
+*
+* Parameters:
+*  stats: destination of the statistics
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_stream_get_stats(hall_stream_stats_t *stats)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    *stats = hall_stream_stats;
+    __set_PRIMASK(primask);
+}
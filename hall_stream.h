@@ -0,0 +1,100 @@
+/*******************************************************************************
+* File Name:   hall_stream.h
+*
+* Description: Delta-encoded stream of the hall sector times.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#ifndef HALL_STREAM_H_
+#define HALL_STREAM_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Number of buffered stream bytes, must be a power of two */
+#ifndef HALL_STREAM_BUFFER_SIZE
+#define HALL_STREAM_BUFFER_SIZE             (256U)
+#endif
+
+/* Maximum number of deltas between two keyframes */
+#ifndef HALL_STREAM_KEYFRAME_INTERVAL
+#define HALL_STREAM_KEYFRAME_INTERVAL       (64U)
+#endif
+
+/* Stream format. Every record is one of:
+ *   0x00 <ticks:5> <ms:5>  keyframe: sector time and time of the edge in
+ *                          milliseconds, each in five bytes of seven bits,
+ *                          least significant first, with bit 7 set
+ *   0x01                   wrong hall event, prediction unchanged
+ *   0x02 <record>          the following sector time was interpolated
+ *   <varint>               zig-zag mapped delta to the previous sector time
+ *                          plus HALL_STREAM_DELTA_OFFSET, seven bits per
+ *                          byte, least significant first, bit 7 set on all
+ *                          but the last byte
+ * 0x00 never occurs outside the keyframe marker, so a decoder synchronises
+ * at any keyframe. tools/hall_stream_decode.c decodes the stream */
+#define HALL_STREAM_KEYFRAME                (0x00U)
+#define HALL_STREAM_KEYFRAME_LENGTH         (11U)
+
+#define HALL_STREAM_WHE                     (0x01U)
+#define HALL_STREAM_INTERPOLATED            (0x02U)
+#define HALL_STREAM_DELTA_OFFSET            (3U)
+
+/*******************************************************************************
+* Data structure and enumeration
+*******************************************************************************/
+typedef struct
+{
+    uint32_t edges;         /* Sector times encoded */
+    uint32_t interpolated;  /* Sector times marked as interpolated */
+    uint32_t bytes;         /* Bytes written to the buffer */
+    uint32_t keyframes;     /* Keyframes written to the buffer */
+    uint32_t wrong_events;  /* Wrong hall events marked */
+    uint32_t dropped;       /* Records dropped because the buffer was full */
+} hall_stream_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void hall_stream_reset(void);
+void hall_stream_tick(void);
+void hall_stream_push(uint32_t sector_ticks, bool interpolated);
+void hall_stream_push_whe(void);
+uint32_t hall_stream_start_chunk(void);
+uint32_t hall_stream_read(uint8_t *data, uint32_t max_count);
+void hall_stream_get_stats(hall_stream_stats_t *stats);
+
+#endif /* HALL_STREAM_H_ */
@@ -0,0 +1,230 @@
+/*******************************************************************************
+* File Name:   hall_trip.c
+*
+* Description: Overspeed and underspeed monitoring using the compare and period
+*              match of the CCU4 speed timer. Software reports the trips; no
+*              hardware trap is connected.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "cybsp.h"
+#include "hall_speed.h"
+#include "hall_trip.h"
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Longest sector time the speed timer can measure */
+#define HALL_TRIP_MAX_TICKS                 (0xFFFFU)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* Latched HALL_TRIP_OVERSPEED and HALL_TRIP_UNDERSPEED bits */
+static volatile uint32_t hall_trip_status = 0U;
+
+/*******************************************************************************
+* Function Name: hall_trip_ticks
+********************************************************************************
+* Summary:
+*  Converts a speed into the sector time in speed timer ticks, limited to the
+*  timer range.
+*
+* Parameters:
+*  rpm: motor speed in rpm, 0 for the longest sector time
+*
+* Return:
+*  uint32_t: sector time in speed timer ticks
+*
+*******************************************************************************/
+static uint32_t hall_trip_ticks(uint32_t rpm)
+{
+    uint32_t ticks = HALL_TRIP_MAX_TICKS;
+
+    if (rpm != 0U)
+    {
+        /* rpm = numerator / ticks, so the same division gives ticks from rpm */
+        ticks = hall_speed_get_rpm(rpm);
+    }
+
+    return (ticks < HALL_TRIP_MAX_TICKS) ? ticks : HALL_TRIP_MAX_TICKS;
+}
+
+/*******************************************************************************
+* Function Name: hall_trip_init
+********************************************************************************
+* Summary:
+*  Configures the speed timer slice for the speed trip. A period match, i.e.
+*  a sector longer than the underspeed limit, raises the HALL_TRIP_SR_ID
+*  service request. The compare and period values are taken over from their
+*  shadow registers whenever a capture clears the timer, so new limits apply
+*  from the next sector. Must be called before the speed timer is started.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_trip_init(void)
+{
+    HALL_SPEED_TIMER_HW->TC |= CCU4_CC4_TC_CLST_Msk;
+
+    XMC_CCU4_SLICE_SetInterruptNode(HALL_SPEED_TIMER_HW, XMC_CCU4_SLICE_IRQ_ID_PERIOD_MATCH, HALL_TRIP_SR_ID);
+    XMC_CCU4_SLICE_EnableEvent(HALL_SPEED_TIMER_HW, XMC_CCU4_SLICE_IRQ_ID_PERIOD_MATCH);
+
+    hall_trip_set_limits(HALL_TRIP_MIN_RPM, HALL_TRIP_MAX_RPM);
+    XMC_CCU4_SLICE_ClearEvent(HALL_SPEED_TIMER_HW, XMC_CCU4_SLICE_IRQ_ID_COMPARE_MATCH_UP);
+    hall_trip_reset();
+}
+
+/*******************************************************************************
+* Function Name: hall_trip_set_limits
+********************************************************************************
+* Summary:
+*  Sets the speed limits. The period of the speed timer becomes the sector
+*  time of the lower limit, so the timer reaches its period match when the
+*  motor is too slow. The compare value becomes the sector time of the upper
+*  limit; a capture before the compare match is an overspeed.
+*
+* Parameters:
+*  min_rpm: lowest allowed speed, 0 for the lowest measurable speed
+*  max_rpm: highest allowed speed, 0 to disable the overspeed trip
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_trip_set_limits(uint32_t min_rpm, uint32_t max_rpm)
+{
+    uint32_t min_ticks = (max_rpm != 0U) ? hall_trip_ticks(max_rpm) : 0U;
+
+    XMC_CCU4_SLICE_SetTimerPeriodMatch(HALL_SPEED_TIMER_HW, (uint16_t)hall_trip_ticks(min_rpm));
+    XMC_CCU4_SLICE_SetTimerCompareMatch(HALL_SPEED_TIMER_HW, (uint16_t)min_ticks);
+    XMC_CCU4_EnableShadowTransfer(HALL_TRIP_CCU4_MODULE, HALL_TRIP_SHADOW_TRANSFER);
+}
+
+/*******************************************************************************
+* Function Name: hall_trip_check_capture
+********************************************************************************
+* Summary:
+*  Checks a new capture against the upper speed limit. The compare match
+*  flag is set by the hardware once the sector time reaches the limit; a
+*  capture without it ends a sector that was too short. Called from the
+*  correct hall event interrupt for every capture, so that the flag is
+*  cleared for the next sector, but only a full sector time, i.e. neither a
+*  wrapped capture nor the partial first one, is checked. The check runs in
+*  software; an overspeed is not detected while this interrupt is delayed.
+*
+* Parameters:
+*  valid: true if the capture is a full sector time
+*
+* Return:
+*  bool: true if the capture tripped the overspeed limit
+*
+*******************************************************************************/
+bool hall_trip_check_capture(bool valid)
+{
+    bool overspeed = false;
+
+    if (HALL_SPEED_TIMER_HW->CR != 0U)
+    {
+        overspeed = valid && !XMC_CCU4_SLICE_GetEvent(HALL_SPEED_TIMER_HW, XMC_CCU4_SLICE_IRQ_ID_COMPARE_MATCH_UP);
+        XMC_CCU4_SLICE_ClearEvent(HALL_SPEED_TIMER_HW, XMC_CCU4_SLICE_IRQ_ID_COMPARE_MATCH_UP);
+    }
+
+    if (overspeed)
+    {
+        hall_trip_status |= HALL_TRIP_OVERSPEED;
+    }
+
+    return overspeed;
+}
+
+/*******************************************************************************
+* Function Name: hall_trip_underspeed
+********************************************************************************
+* Summary:
+*  Latches the underspeed trip. Called from the HALL_TRIP_SR_ID interrupt.
+*  The period match flag itself is left to the capture handling, which
+*  discards the capture of the overlong sector.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_trip_underspeed(void)
+{
+    hall_trip_status |= HALL_TRIP_UNDERSPEED;
+}
+
+/*******************************************************************************
+* Function Name: hall_trip_get_status
+********************************************************************************
+* Summary:
+*  Returns the latched trips.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t: HALL_TRIP_OVERSPEED and HALL_TRIP_UNDERSPEED bits
+*
+*******************************************************************************/
+uint32_t hall_trip_get_status(void)
+{
+    return hall_trip_status;
+}
+
+/*******************************************************************************
+* Function Name: hall_trip_reset
+********************************************************************************
+* Summary:
+*  Clears the latched trips. A trip whose cause persists is latched again by
+*  the next sector.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_trip_reset(void)
+{
+    hall_trip_status = 0U;
+}
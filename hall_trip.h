@@ -0,0 +1,84 @@
+/*******************************************************************************
+* File Name:   hall_trip.h
+*
+* Description: Overspeed and underspeed monitoring using the compare and period
+*              match of the CCU4 speed timer. Software reports the trips; no
+*              hardware trap is connected.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#ifndef HALL_TRIP_H_
+#define HALL_TRIP_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Speed limits in rpm. The lower limit is raised to the lowest speed the
+ * 16-bit speed timer can measure */
+#ifndef HALL_TRIP_MIN_RPM
+#define HALL_TRIP_MIN_RPM                   (0U)
+#endif
+
+#ifndef HALL_TRIP_MAX_RPM
+#define HALL_TRIP_MAX_RPM                   (30000U)
+#endif
+
+/* Service request line and interrupt of the underspeed trip */
+#ifndef HALL_TRIP_SR_ID
+#define HALL_TRIP_SR_ID                     (XMC_CCU4_SLICE_SR_ID_3)
+#define HALL_TRIP_IRQn                      (CCU40_3_IRQn)
+#define HALL_TRIP_IRQHandler                CCU40_3_IRQHandler
+#endif
+
+/* Shadow transfer request of the speed timer slice (CCU40 slice 1 on all kits) */
+#define HALL_TRIP_CCU4_MODULE               (CCU40)
+#define HALL_TRIP_SHADOW_TRANSFER           (XMC_CCU4_SHADOW_TRANSFER_SLICE_1)
+
+/* Trip status bits */
+#define HALL_TRIP_OVERSPEED                 (0x01U)
+#define HALL_TRIP_UNDERSPEED                (0x02U)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void hall_trip_init(void);
+void hall_trip_set_limits(uint32_t min_rpm, uint32_t max_rpm);
+bool hall_trip_check_capture(bool valid);
+void hall_trip_underspeed(void);
+uint32_t hall_trip_get_status(void);
+void hall_trip_reset(void);
+
+#endif /* HALL_TRIP_H_ */
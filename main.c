@@ -42,6 +42,27 @@
 #include "cybsp.h"
 #include "cy_utils.h"
 #include "cy_retarget_io.h"
+#include "benchmark.h"
+#include "boot_profile.h"
+#include "hall_angle.h"
+#include "hall_detect.h"
+#include "hall_duty.h"
+#include "hall_edge_buffer.h"
+#include "hall_filter.h"
+#include "hall_health.h"
+#include "hall_input.h"
+#include "hall_jitter.h"
+#include "hall_kalman.h"
+#include "hall_order.h"
+#include "hall_placement.h"
+#include "hall_resync.h"
+#include "hall_shell.h"
+#include "hall_spectrum.h"
+#include "hall_speed.h"
+#include "hall_stats.h"
+#include "hall_storm.h"
+#include "hall_stream.h"
+#include "hall_trip.h"
 #include <stdio.h>
 
 /*******************************************************************************
@@ -50,14 +71,89 @@
 #define TICKS_PER_SECOND                    (1000U)
 #define TICKS_WAIT                          (100U)
 
-/* Define macro to enable/disable printing of debug messages */
-#define ENABLE_XMC_DEBUG_PRINT              (0)
+/* Shadow transfer request of the simulated hall signal slices (CCU80 slices 0
+ * to 2 on all kits) */
+#define HALL_SIM_CCU8_MODULE                (CCU80)
+#define HALL_SIM_SHADOW_TRANSFER            (XMC_CCU8_SHADOW_TRANSFER_SLICE_0 | \
+                                             XMC_CCU8_SHADOW_TRANSFER_SLICE_1 | \
+                                             XMC_CCU8_SHADOW_TRANSFER_SLICE_2)
 
 /* Define macro to set the loop count before printing debug messages */
 #if ENABLE_XMC_DEBUG_PRINT
 #define DEBUG_LOOP_COUNT_MAX                (3U)
 #endif
 
+/* The speed timer captures on capture trigger 0 only, which fills CV0 and
+ * CV1; CV2 and CV3 belong to capture trigger 1 */
+#define CAPTURE_FIFO_DEPTH                  (2U)
+
+/* The XMC4500/4400/4200/4100 devices read the FIFO through the ECRD register
+ * of the module, the others through the ECRD0 register of the slice */
+#if defined(CCU4V1)
+#define CAPTURE_FIFO_MODULE                 (CCU40)
+#define CAPTURE_FIFO_SLICE                  (1U)
+#define CAPTURE_FIFO_FFL_Msk                (CCU4_ECRD_FFL_Msk)
+#define CAPTURE_FIFO_LCV_Msk                (CCU4_ECRD_LCV_Msk)
+#define CAPTURE_FIFO_CAPV_Msk               (CCU4_ECRD_CAPV_Msk)
+#else
+#define CAPTURE_FIFO_FFL_Msk                (CCU4_CC4_ECRD0_FFL_Msk)
+#define CAPTURE_FIFO_LCV_Msk                (CCU4_CC4_ECRD0_LCV_Msk)
+#define CAPTURE_FIFO_CAPV_Msk               (CCU4_CC4_ECRD0_CAPV_Msk)
+#endif
+
+#if ENABLE_CAPTURE_FIFO && ENABLE_HALL_DUTY_MONITOR
+#error "The duty cycle monitor needs the hall pattern of every event and cannot be used with ENABLE_CAPTURE_FIFO"
+#endif
+
+#if (HALL_SENSOR_PLACEMENT != HALL_PLACEMENT_120) && ENABLE_HALL_AUTO_DETECT
+#error "Hall sequence auto-detection supports the 120 degree sensor placement only"
+#endif
+
+#if (HALL_SENSOR_PLACEMENT == HALL_PLACEMENT_TWO_SENSOR) && (ENABLE_CAPTURE_FIFO || ENABLE_HALL_DUTY_MONITOR)
+#error "The two-sensor placement needs the hall pattern of every event and cannot be used with ENABLE_CAPTURE_FIFO or ENABLE_HALL_DUTY_MONITOR"
+#endif
+
+#if ENABLE_CAPTURE_FIFO && ENABLE_HALL_RESYNC
+#error "The hall resynchronisation restarts the speed timer and cannot be used with ENABLE_CAPTURE_FIFO"
+#endif
+
+#if ENABLE_CAPTURE_FIFO && ENABLE_ORDER_TRACKING
+#error "The order tracking needs the hall code of every event and cannot be used with ENABLE_CAPTURE_FIFO"
+#endif
+
+#if ENABLE_CAPTURE_FIFO && ENABLE_SPEED_TRIP
+#error "The overspeed trip checks every capture and cannot be used with ENABLE_CAPTURE_FIFO"
+#endif
+
+/* Marks the sector times interpolated by the hall resynchronisation */
+#if ENABLE_HALL_RESYNC
+#define SECTOR_INTERPOLATED                 (sector_interpolated)
+#else
+#define SECTOR_INTERPOLATED                 (false)
+#endif
+
+/* Sector times are queued for the consumers in the main loop */
+#define ENABLE_EDGE_BUFFER                  (ENABLE_CMSIS_DSP_FILTER || ENABLE_SPEED_SPECTRUM)
+
+/* Maximum number of sector times handled per main loop iteration */
+#define EDGE_BLOCK_SIZE                     (HALL_FILTER_BLOCK_SIZE)
+
+/* Number of edge stream bytes printed per line */
+#define EDGE_STREAM_LINE_SIZE               (32U)
+
+#if ENABLE_HALL_RESYNC
+/*******************************************************************************
+* Data structure and enumeration
+*******************************************************************************/
+/* Occasion of a hall resynchronisation */
+typedef enum
+{
+    RESYNC_AT_EDGE,         /* Wrong hall event interrupt, at the edge */
+    RESYNC_POLLED,          /* Wrong hall event polled while its interrupt is masked */
+    RESYNC_OVERDUE          /* Edge that caused no event, found overdue */
+} resync_cause_t;
+#endif
+
 /*******************************************************************************
 * Global variables
 *******************************************************************************/
@@ -70,20 +166,94 @@ uint8_t ccu8_pulse_counter = 0;
 /* Timers flag */
 bool timers_started = false;
 
-/* Hall input array */
-uint8_t hall[3] = {0,0,0};
+#if ENABLE_HALL_AUTO_DETECT
+/* Set once the hall sequence has been detected and programmed */
+static bool hall_sequence_detected = false;
+#endif
+
+/* Set when the speed timer starts; its first capture covers a partial sector */
+static bool first_capture_pending = false;
 
 /* Hall position variable */
 uint8_t hall_position = 0;
 
+/* Current and expected hall pattern for every hall position. Initialised from
+ * the POSIF personality, the selected sensor placement, or from the
+ * auto-detected sequence */
+static uint8_t hall_patterns[8];
+
+#if (HALL_SENSOR_PLACEMENT == HALL_PLACEMENT_TWO_SENSOR)
+/* Hall code of the sector timed by the speed timer */
+static uint8_t hall_sector_code = 0;
+#endif
+
 /* Correct hall event variable */
 unsigned long hall_events_interval = 0;
 
+/* Motor speed in rpm derived from the correct hall event interval */
+unsigned long hall_speed_rpm = 0;
+
+/* Speed timer ticks between the last two correct hall events */
+uint32_t hall_events_ticks = 0;
+
+/* Number of hall sectors longer than the speed timer range */
+uint32_t speed_timer_overflows = 0;
+
+#if ENABLE_HALL_RESYNC
+/* Set while sector times interpolated across a missed edge are processed */
+static bool sector_interpolated = false;
+#endif
+
+#if ENABLE_JITTER_HISTOGRAM
+/* Set from the debugger to print the jitter histogram with the next report */
+volatile bool hall_jitter_dump_requested = false;
+#endif
+
+#if ENABLE_BOOT_PROFILE
+/* The SysTick timer runs from the start of main(); set once the peripherals
+ * and retarget-io are initialized and the handler may use them */
+static volatile bool systick_ready = false;
+#endif
+
+#if ENABLE_CAPTURE_FIFO
+/* Number of drains that found captures lost because the FIFO was full */
+uint32_t capture_fifo_overruns = 0;
+#endif
+
+#if ENABLE_CMSIS_DSP_FILTER
+/* Low-pass filtered sector time and the speed derived from it */
+uint32_t hall_filtered_ticks = 0;
+unsigned long hall_filtered_rpm = 0;
+#endif
+
+#if ENABLE_MATH_COPROCESSOR
+/* Interpolated electrical angle (0x10000 = 360 degrees) and its sine in Q15 */
+uint16_t hall_electrical_angle = 0;
+int16_t hall_electrical_sine = 0;
+#endif
+
 #if ENABLE_XMC_DEBUG_PRINT
 /* Initialize the current loop count to zero */
 static uint32_t debug_loop_count = 0;
 #endif
 
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void start_hall_capture(void);
+#if (HALL_SENSOR_PLACEMENT != HALL_PLACEMENT_120)
+static void configure_hall_simulation(void);
+#endif
+static void process_sector_time(uint32_t sector_ticks, uint8_t hall_pattern);
+#if ENABLE_CAPTURE_FIFO
+static void drain_capture_fifo(void);
+#endif
+#if ENABLE_HALL_RESYNC
+static void restart_speed_timer(bool wrapped);
+static void resync_hall_state(resync_cause_t cause);
+#endif
+static void handle_wrong_hall_event(bool at_edge);
+
  /*******************************************************************************
  * Function Name: SysTick Handler
  ********************************************************************************
@@ -106,10 +276,254 @@ void SysTick_Handler(void)
 
     ticks++;
 
+    /* Time base of the boot profile */
+    BOOT_PROFILE_TICK();
+
+    #if ENABLE_BOOT_PROFILE
+    if (!systick_ready)
+    {
+        return;
+    }
+    #endif
+
+    /* Advance the health monitor windows */
+    HALL_HEALTH_TICK();
+
+    #if ENABLE_EDGE_STREAM
+    /* Time base of the edge stream keyframes */
+    hall_stream_tick();
+    #endif
+
+    #if ENABLE_CAPTURE_FIFO
+    /* Collect the sector times captured during the last tick */
+    if (timers_started)
+    {
+        drain_capture_fifo();
+    }
+    #endif
+
+    #if ENABLE_WHE_STORM_LIMIT
+    {
+        uint32_t whe_events = 0U;
+
+        /* While the wrong hall event interrupt is masked, its events are
+         * collected and handled here */
+        if (hall_storm_is_active())
+        {
+            whe_events = hall_storm_poll();
+            if (whe_events != 0U)
+            {
+                handle_wrong_hall_event(false);
+            }
+        }
+        if (hall_storm_tick(whe_events))
+        {
+            XMC_POSIF_ClearEvent(HALL_POSIF_HW, XMC_POSIF_IRQ_EVENT_WHE);
+            XMC_POSIF_EnableEvent(HALL_POSIF_HW, XMC_POSIF_IRQ_EVENT_WHE);
+        }
+    }
+    #endif
+
+    #if ENABLE_HALL_RESYNC
+    /* An edge that neither caused a correct nor a wrong hall event */
+    if (timers_started && hall_resync_is_overdue(XMC_CCU4_SLICE_GetTimerValue(HALL_SPEED_TIMER_HW)) &&
+        (XMC_POSIF_HSC_GetLastSampledPattern(HALL_POSIF_HW) != hall_resync_get_code()))
+    {
+        resync_hall_state(RESYNC_OVERDUE);
+    }
+    #endif
+
     /* Wait for 500ms delay */
     if (ticks == TICKS_WAIT)
     {
         ticks = 0;
+
+        #if ENABLE_HEALTH_MONITOR
+        {
+            static const char *const health_status[] = { "ok", "degraded", "fault" };
+            uint32_t score_1s = hall_health_get_score(HALL_HEALTH_WINDOW_1S);
+            uint32_t score_1min = hall_health_get_score(HALL_HEALTH_WINDOW_1MIN);
+            uint32_t score_1h = hall_health_get_score(HALL_HEALTH_WINDOW_1H);
+
+            /* Print the health score of each window, rated by the 1 min window */
+            printf("Health score: %lu (1s), %lu (1min), %lu (1h), %s\r\n",
+                    (unsigned long)score_1s, (unsigned long)score_1min, (unsigned long)score_1h,
+                    health_status[hall_health_get_status(score_1min)]);
+        }
+        #endif
+
+        #if ENABLE_WHE_STORM_LIMIT
+        {
+            hall_storm_stats_t storm;
+            static uint32_t storm_count = 0;
+
+            /* Report storms in progress and storms since the last report */
+            hall_storm_get_stats(&storm);
+            if (storm.active || (storm.storms != storm_count))
+            {
+                storm_count = storm.storms;
+                printf("Wrong hall event storm: %lu storms, %lu events suppressed%s\r\n",
+                        (unsigned long)storm.storms, (unsigned long)storm.suppressed,
+                        storm.active ? ", interrupt masked" : "");
+            }
+        }
+        #endif
+
+        #if ENABLE_SPEED_TRIP
+        /* Report and re-arm the speed trip; a persisting fault trips again */
+        if (hall_trip_get_status() != 0U)
+        {
+            printf("Speed trip:%s%s\r\n",
+                    (hall_trip_get_status() & HALL_TRIP_OVERSPEED) ? " overspeed" : "",
+                    (hall_trip_get_status() & HALL_TRIP_UNDERSPEED) ? " underspeed" : "");
+            hall_trip_reset();
+        }
+        #endif
+
+        #if ENABLE_EDGE_STREAM
+        {
+            uint8_t stream[EDGE_STREAM_LINE_SIZE];
+            hall_stream_stats_t stream_stats;
+            uint32_t remaining;
+            uint32_t count;
+            uint32_t i;
+
+            /* Print the stream bytes of the last report period in hex. The
+             * next period starts with a keyframe, so every report is a chunk
+             * that can be decoded on its own. Bytes written while printing
+             * already belong to the next chunk and stay buffered */
+            remaining = hall_stream_start_chunk();
+            while (remaining != 0U)
+            {
+                count = hall_stream_read(stream, (remaining < EDGE_STREAM_LINE_SIZE) ? remaining : EDGE_STREAM_LINE_SIZE);
+                remaining -= count;
+                printf("stream ");
+                for (i = 0U; i < count; i++)
+                {
+                    printf("%02x", stream[i]);
+                }
+                printf("\r\n");
+            }
+
+            hall_stream_get_stats(&stream_stats);
+            printf("Edge stream: %lu edges and %lu wrong hall events in %lu bytes, %lu keyframes, %lu dropped\r\n",
+                    (unsigned long)stream_stats.edges, (unsigned long)stream_stats.wrong_events,
+                    (unsigned long)stream_stats.bytes, (unsigned long)stream_stats.keyframes,
+                    (unsigned long)stream_stats.dropped);
+        }
+        #endif
+
+        #if ENABLE_JITTER_HISTOGRAM
+        if (hall_jitter_dump_requested)
+        {
+            static hall_jitter_t jitter;
+            uint32_t bucket;
+
+            hall_jitter_dump_requested = false;
+
+            /* Print the non-empty buckets with their bounds so that dumps
+             * of several boards can be merged bucket by bucket */
+            hall_jitter_snapshot(&jitter);
+            printf("Jitter histogram: %lu deviations from %lu ticks mean, %luns per tick\r\n",
+                    (unsigned long)jitter.count, (unsigned long)jitter.mean,
+                    (unsigned long)HALL_SPEED_TIMER_TICK_NS);
+            for (bucket = 0U; bucket < HALL_JITTER_NUM_BUCKETS; bucket++)
+            {
+                if (jitter.buckets[bucket] != 0U)
+                {
+                    printf("jitter %lu %lu %u\r\n", (unsigned long)hall_jitter_get_bucket_low(bucket),
+                            (unsigned long)hall_jitter_get_bucket_high(bucket), jitter.buckets[bucket]);
+                }
+            }
+        }
+        #endif
+
+        #if ENABLE_HALL_RESYNC
+        {
+            hall_resync_stats_t resync;
+            static uint32_t interpolated_count = 0;
+
+            /* Report the sector times interpolated since the last report */
+            hall_resync_get_stats(&resync);
+            if (resync.interpolated != interpolated_count)
+            {
+                printf("%lu sector times interpolated across missed hall edges\r\n",
+                        (unsigned long)(resync.interpolated - interpolated_count));
+                interpolated_count = resync.interpolated;
+            }
+        }
+        #endif
+
+        {
+            static uint32_t timer_overflow_count = 0;
+            uint32_t overflows = speed_timer_overflows;
+
+            /* Report sectors longer than the speed timer range, e.g. of a stalled motor */
+            if (overflows != timer_overflow_count)
+            {
+                printf("%lu hall sectors longer than the speed timer range\r\n",
+                        (unsigned long)(overflows - timer_overflow_count));
+                timer_overflow_count = overflows;
+            }
+        }
+
+        #if ENABLE_CAPTURE_FIFO
+        {
+            static uint32_t fifo_overrun_count = 0;
+            uint32_t overruns = capture_fifo_overruns;
+
+            /* Report drains that found captures lost since the last report */
+            if (overruns != fifo_overrun_count)
+            {
+                printf("%lu capture FIFO overruns, sector times lost\r\n",
+                        (unsigned long)(overruns - fifo_overrun_count));
+                fifo_overrun_count = overruns;
+            }
+        }
+        #endif
+
+        #if ENABLE_EDGE_BUFFER
+        {
+            static uint32_t edge_overflow_count = 0;
+            uint32_t overflows = hall_edge_buffer_get_overflows();
+
+            /* Report sector times lost because the main loop fell behind */
+            if (overflows != edge_overflow_count)
+            {
+                printf("%lu sector times dropped, edge buffer full\r\n",
+                        (unsigned long)(overflows - edge_overflow_count));
+                edge_overflow_count = overflows;
+            }
+        }
+        #endif
+
+        #if ENABLE_SECTOR_STATS
+        {
+            hall_stats_t sector;
+            hall_stats_t speed;
+
+            /* Print the statistics of all correct hall events since the last
+             * report. The window is restarted with every report, also when it
+             * ended with a wrong hall event */
+            hall_stats_snapshot(&sector, &speed);
+            if (sector.count != 0U)
+            {
+                printf("Time interval between two correct hall events: mean %luns, min %luns, max %luns, "
+                        "stddev %luns (%lu events, %lu interpolated)\r\n",
+                        (unsigned long)(((uint64_t)sector.mean * HALL_SPEED_TIMER_TICK_NS) >> HALL_STATS_FRAC_BITS),
+                        (unsigned long)(sector.min * HALL_SPEED_TIMER_TICK_NS),
+                        (unsigned long)(sector.max * HALL_SPEED_TIMER_TICK_NS),
+                        (unsigned long)(((uint64_t)sector.stddev * HALL_SPEED_TIMER_TICK_NS) >> HALL_STATS_FRAC_BITS),
+                        (unsigned long)sector.count, (unsigned long)sector.interpolated);
+                printf("Speed: mean %lurpm, min %lurpm, max %lurpm, stddev %lu.%02lurpm\r\n",
+                        (unsigned long)(speed.mean >> HALL_STATS_FRAC_BITS),
+                        (unsigned long)speed.min, (unsigned long)speed.max,
+                        (unsigned long)(speed.stddev >> HALL_STATS_FRAC_BITS),
+                        (unsigned long)(((speed.stddev & ((1U << HALL_STATS_FRAC_BITS) - 1U)) * 100U) >> HALL_STATS_FRAC_BITS));
+            }
+        }
+        #endif
+
         /* Check if correct hall event occurs */
         if((che_flag == 1) && (whe_flag == 0))
         {
@@ -120,8 +534,78 @@ void SysTick_Handler(void)
                 if (debug_loop_count == DEBUG_LOOP_COUNT_MAX)
                     printf("All three correct hall events occurs\r\n");
             #else
+                #if !ENABLE_SECTOR_STATS
                 /* Print the time interval between two correct hall events in nano seconds */
-                printf("Time interval between two correct hall events: %luns\r\n", hall_events_interval);
+                printf("Time interval between two correct hall events: %luns, speed: %lurpm\r\n",
+                        hall_events_interval, hall_speed_rpm);
+                #endif
+                BOOT_PROFILE_MARK(BOOT_PHASE_FIRST_SPEED);
+                BOOT_PROFILE_PRINT();
+                #if ENABLE_CMSIS_DSP_FILTER
+                printf("Filtered speed: %lurpm\r\n", hall_filtered_rpm);
+                #endif
+                #if ENABLE_KALMAN_ESTIMATOR
+                printf("Estimated speed: %lurpm, sector time change: %ld ticks per sector\r\n",
+                        (unsigned long)hall_speed_get_rpm(hall_kalman_predict(XMC_CCU4_SLICE_GetTimerValue(HALL_SPEED_TIMER_HW))),
+                        (long)hall_kalman_get_sector_slope());
+                #endif
+                #if ENABLE_MATH_COPROCESSOR
+                printf("Electrical angle: %ludeg, sine: %ld permille\r\n",
+                        (unsigned long)(((uint32_t)hall_electrical_angle * 360U) >> 16),
+                        (long)(((int32_t)hall_electrical_sine * 1000) / 32768));
+                #endif
+                #if ENABLE_SPEED_SPECTRUM
+                {
+                    hall_spectrum_result_t spectrum;
+                    static uint32_t spectrum_block = 0;
+
+                    /* Print the speed ripple of every new FFT block */
+                    hall_spectrum_get_result(&spectrum);
+                    if (spectrum.block != spectrum_block)
+                    {
+                        spectrum_block = spectrum.block;
+                        printf("Speed ripple (permille):");
+                        for (uint32_t i = 0; i < HALL_SPECTRUM_NUM_ORDERS; i++)
+                        {
+                            printf(" %u", spectrum.ripple_permille[i]);
+                        }
+                        printf("\r\n");
+                    }
+                }
+                #endif
+                #if ENABLE_ORDER_TRACKING
+                {
+                    int16_t deviation[HALL_ORDER_SECTORS_PER_REV];
+
+                    /* Print every new per-revolution sector time profile */
+                    if (hall_order_get_profile(deviation, NULL))
+                    {
+                        printf("Sector time profile (permille):");
+                        for (uint32_t i = 0; i < HALL_ORDER_SECTORS_PER_REV; i++)
+                        {
+                            printf(" %d", deviation[i]);
+                        }
+                        printf("\r\n");
+                    }
+                }
+                #endif
+                #if ENABLE_HALL_DUTY_MONITOR
+                {
+                    hall_duty_stats_t duty[HALL_DUTY_NUM_SENSORS];
+
+                    /* Print the averaged duty cycle of each hall sensor */
+                    (void)hall_duty_get_stats(duty);
+                    printf("Hall duty cycle (permille): %u %u %u\r\n",
+                            duty[0].average, duty[1].average, duty[2].average);
+                    for (uint32_t i = 0; i < HALL_DUTY_NUM_SENSORS; i++)
+                    {
+                        if (duty[i].alarm)
+                        {
+                            printf("Hall sensor %lu duty cycle alarm\r\n", (unsigned long)(i + 1U));
+                        }
+                    }
+                }
+                #endif
             #endif
         }
         /* Check if wrong hall event occurs */
@@ -131,10 +615,402 @@ void SysTick_Handler(void)
             whe_flag = 0;
             /* Print the wrong hall event */
             printf("Wrong hall event\r\n");
+            #if ENABLE_HALL_RESYNC
+            {
+                hall_resync_stats_t resync;
+
+                hall_resync_get_stats(&resync);
+                printf("Hall resync: %lu glitches, %lu missed edges, %lu lost\r\n",
+                        (unsigned long)resync.glitches, (unsigned long)resync.missed_edges,
+                        (unsigned long)resync.lost);
+            }
+            #endif
         }
     }
 }
 
+#if (HALL_SENSOR_PLACEMENT != HALL_PLACEMENT_120)
+/*******************************************************************************
+* Function Name: configure_hall_simulation
+********************************************************************************
+* Summary:
+*  Shapes the 120 degree hall signals of the CCU8 timers like the selected
+*  sensor placement, before the timers are started. A high passive level
+*  inverts an output, e.g. the middle sensor of the 60 degree placement. A
+*  compare value above the period keeps an output low, e.g. HALL_INPUT_3 of
+*  the two-sensor placement; its period match still paces the startup.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void configure_hall_simulation(void)
+{
+    XMC_CCU8_SLICE_t *const slices[3] = { HALL_1_HW, HALL_2_HW, HALL_3_HW };
+    uint32_t i;
+
+    for (i = 0U; i < 3U; i++)
+    {
+        if ((HALL_PLACEMENT_SIM_INVERTED & (1U << i)) != 0U)
+        {
+            XMC_CCU8_SLICE_SetPassiveLevel(slices[i], XMC_CCU8_SLICE_OUTPUT_0,
+                                           XMC_CCU8_SLICE_OUTPUT_PASSIVE_LEVEL_HIGH);
+        }
+        if ((HALL_PLACEMENT_SIM_HELD_LOW & (1U << i)) != 0U)
+        {
+            XMC_CCU8_SLICE_SetTimerCompareMatch(slices[i], XMC_CCU8_SLICE_COMPARE_CHANNEL_1,
+                                                (uint16_t)(XMC_CCU8_SLICE_GetTimerPeriodMatch(slices[i]) + 1U));
+        }
+    }
+
+    /* The timers are stopped, so the transfer takes effect at once */
+    XMC_CCU8_EnableShadowTransfer(HALL_SIM_CCU8_MODULE, HALL_SIM_SHADOW_TRANSFER);
+}
+#endif
+
+/*******************************************************************************
+* Function Name: start_hall_capture
+********************************************************************************
+* Summary:
+*  Starts the POSIF module with the current hall pattern and the CCU4 delay
+*  and speed timers.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void start_hall_capture(void)
+{
+    /* Start the Encoder */
+    XMC_POSIF_Start(HALL_POSIF_HW);
+
+    /* Read the Hall input GPIO pins */
+    hall_position = hall_input_read();
+
+    /* Configure current and expected hall patterns */
+    XMC_POSIF_HSC_SetHallPatterns(HALL_POSIF_HW, hall_patterns[hall_placement_is_valid(hall_position) ?
+            hall_position : hall_placement_get_first_code()]);
+
+    /* Update hall pattern */
+    XMC_POSIF_HSC_UpdateHallPattern(HALL_POSIF_HW);
+
+    /* The first capture only covers the part of the sector after the start */
+    first_capture_pending = true;
+
+    #if (HALL_SENSOR_PLACEMENT == HALL_PLACEMENT_TWO_SENSOR)
+    hall_sector_code = hall_position;
+    #endif
+
+    #if ENABLE_HALL_RESYNC
+    /* Track the hall sequence to recognise missed edges */
+    hall_resync_reset(hall_patterns, hall_position);
+    #endif
+
+    /* Start CCU4 timers */
+    XMC_CCU4_SLICE_StartTimer(HALL_DELAY_TIMER_HW);
+    XMC_CCU4_SLICE_StartTimer(HALL_SPEED_TIMER_HW);
+
+    /* Sets the timers flag to the true value */
+    timers_started = true;
+
+    BOOT_PROFILE_MARK(BOOT_PHASE_POSIF_START);
+}
+
+/*******************************************************************************
+* Function Name: process_sector_time
+********************************************************************************
+* Summary:
+*  Calculates the speed from the speed timer value captured between two
+*  correct hall events and passes it to the enabled estimators.
+*
+* Parameters:
+*  sector_ticks: captured speed timer value of one hall sector
+*  hall_pattern: hall pattern at the end of the sector
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void process_sector_time(uint32_t sector_ticks, uint8_t hall_pattern)
+{
+    BOOT_PROFILE_MARK(BOOT_PHASE_FIRST_CHE);
+
+    /* The speed timer was started in the middle of a sector */
+    if (first_capture_pending)
+    {
+        first_capture_pending = false;
+        return;
+    }
+
+    /* Start the speed conversion; with the MATH coprocessor it runs
+     * in parallel to the interval calculation below */
+    hall_speed_start_rpm(sector_ticks);
+
+    /* Calculate the time between two correct hall events
+     * (captured_value * prescaler * 1000) / clock */
+    hall_events_interval = sector_ticks * HALL_SPEED_TIMER_TICK_NS;
+    hall_events_ticks = sector_ticks;
+
+    hall_speed_rpm = hall_speed_read_rpm();
+
+    #if ENABLE_SECTOR_STATS
+    /* Accumulate the statistics of the report window */
+    hall_stats_update(sector_ticks, hall_speed_rpm, SECTOR_INTERPOLATED);
+    #endif
+
+    #if ENABLE_JITTER_HISTOGRAM
+    /* Count the deviation of the sector time from its running mean */
+    hall_jitter_update(sector_ticks);
+    #endif
+
+    #if ENABLE_EDGE_STREAM
+    /* Append the sector time to the compressed edge stream */
+    hall_stream_push(sector_ticks, SECTOR_INTERPOLATED);
+    #endif
+
+    #if ENABLE_KALMAN_ESTIMATOR
+    /* Update the speed estimate with the new sector time */
+    hall_kalman_update(sector_ticks);
+    #endif
+
+    #if ENABLE_HALL_DUTY_MONITOR
+    /* Credit the sector time to the sensors that were high */
+    hall_duty_update(hall_pattern, sector_ticks);
+    #else
+    (void)hall_pattern;
+    #endif
+
+    #if ENABLE_ORDER_TRACKING
+    /* Accumulate the sector time into the per-revolution profile */
+    hall_order_update(sector_ticks);
+    #endif
+
+    #if ENABLE_EDGE_BUFFER
+    /* Queue the sector time for block processing in the main loop */
+    (void)hall_edge_buffer_push(sector_ticks);
+    #endif
+}
+
+#if ENABLE_CAPTURE_FIFO
+/*******************************************************************************
+* Function Name: drain_capture_fifo
+********************************************************************************
+* Summary:
+*  Reads all sector times from the speed timer capture FIFO, oldest first.
+*  Each read of the extended capture read register returns the oldest full
+*  capture register and clears its full flag. With both registers full,
+*  further captures are dropped by the hardware, which sets the lost capture
+*  flag of the register; the drain then counts an overrun.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void drain_capture_fifo(void)
+{
+    uint32_t captured_value;
+    uint32_t count = 0;
+    bool lost = false;
+    bool wrapped;
+
+    /* Only the oldest sector can be long enough to wrap the timer, because
+     * the FIFO is drained much more often than the timer range */
+    wrapped = XMC_CCU4_SLICE_GetEvent(HALL_SPEED_TIMER_HW, XMC_CCU4_SLICE_IRQ_ID_PERIOD_MATCH);
+
+    while (count < CAPTURE_FIFO_DEPTH)
+    {
+        #if defined(CCU4V1)
+        int32_t fifo_value = XMC_CCU4_GetCapturedValueFromFifo(CAPTURE_FIFO_MODULE, CAPTURE_FIFO_SLICE);
+
+        /* Only the speed timer runs in extended capture mode */
+        captured_value = (fifo_value < 0) ? 0U : (uint32_t)fifo_value;
+        #else
+        captured_value = XMC_CCU4_SLICE_GetCapturedValueFromFifo(HALL_SPEED_TIMER_HW, XMC_CCU4_SLICE_CAP_REG_SET_LOW);
+        #endif
+        if ((captured_value & CAPTURE_FIFO_LCV_Msk) != 0U)
+        {
+            lost = true;
+        }
+        if ((captured_value & CAPTURE_FIFO_FFL_Msk) == 0U)
+        {
+            break;
+        }
+
+        if ((count == 0U) && wrapped)
+        {
+            XMC_CCU4_SLICE_ClearEvent(HALL_SPEED_TIMER_HW, XMC_CCU4_SLICE_IRQ_ID_PERIOD_MATCH);
+            speed_timer_overflows++;
+            HALL_HEALTH_COUNT(HALL_HEALTH_STALL);
+
+            #if ENABLE_KALMAN_ESTIMATOR
+            /* The sector time sequence has a gap */
+            hall_kalman_init();
+            #endif
+        }
+        else
+        {
+            process_sector_time(captured_value & CAPTURE_FIFO_CAPV_Msk,
+                                (uint8_t)XMC_POSIF_HSC_GetLastSampledPattern(HALL_POSIF_HW));
+        }
+        HALL_HEALTH_COUNT(HALL_HEALTH_CHE);
+        count++;
+    }
+
+    if (lost)
+    {
+        capture_fifo_overruns++;
+    }
+
+    if (count != 0U)
+    {
+        che_flag = 1;
+        whe_flag = 0;
+    }
+}
+#endif
+
+#if ENABLE_HALL_RESYNC
+/*******************************************************************************
+* Function Name: restart_speed_timer
+********************************************************************************
+* Summary:
+*  Restarts the speed timer at a resynchronisation and consumes its wrap flag,
+*  which would otherwise mark the next capture as wrapped.
+*
+* Parameters:
+*  wrapped: true if the speed timer wrapped since the last edge
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void restart_speed_timer(bool wrapped)
+{
+    XMC_CCU4_SLICE_ClearTimer(HALL_SPEED_TIMER_HW);
+    XMC_CCU4_SLICE_ClearEvent(HALL_SPEED_TIMER_HW, XMC_CCU4_SLICE_IRQ_ID_PERIOD_MATCH);
+
+    if (wrapped)
+    {
+        speed_timer_overflows++;
+        HALL_HEALTH_COUNT(HALL_HEALTH_STALL);
+    }
+}
+
+/*******************************************************************************
+* Function Name: resync_hall_state
+********************************************************************************
+* Summary:
+*  Resynchronises the POSIF to the hall code it sampled last, after a wrong
+*  hall event or an overdue edge. A single missed edge at a wrong hall event
+*  is bridged by interpolating the skipped sector times from the time since
+*  the last edge. Otherwise the speed estimation restarts. In both cases the
+*  speed timer restarts and the patterns are reprogrammed for the new code.
+*
+* Parameters:
+*  cause: occasion; only at the edge itself is the edge time known
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void resync_hall_state(resync_cause_t cause)
+{
+    bool edge_seen = (cause == RESYNC_AT_EDGE);
+    uint32_t primask;
+    uint32_t elapsed_ticks = UINT32_MAX;
+    uint32_t sector_ticks;
+    uint32_t sectors = 0U;
+    uint32_t code_sectors;
+    uint8_t hall_code;
+    uint8_t sector_code;
+    bool wrapped;
+
+    /* Keep the correct hall event interrupt from using the timer meanwhile */
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    hall_code = (uint8_t)XMC_POSIF_HSC_GetLastSampledPattern(HALL_POSIF_HW);
+    sector_code = hall_resync_get_code();
+
+    /* A correct hall event may have ended the overdue sector between the
+     * check in the SysTick handler and here, so check again */
+    if ((cause == RESYNC_OVERDUE) && ((hall_code == sector_code) ||
+        !hall_resync_is_overdue(XMC_CCU4_SLICE_GetTimerValue(HALL_SPEED_TIMER_HW))))
+    {
+        __set_PRIMASK(primask);
+        return;
+    }
+
+    /* The time since the last edge is only known at the edge itself, and only
+     * if the speed timer has not wrapped */
+    wrapped = XMC_CCU4_SLICE_GetEvent(HALL_SPEED_TIMER_HW, XMC_CCU4_SLICE_IRQ_ID_PERIOD_MATCH);
+    if (!wrapped && edge_seen)
+    {
+        elapsed_ticks = XMC_CCU4_SLICE_GetTimerValue(HALL_SPEED_TIMER_HW);
+    }
+
+    switch (hall_resync_recover(hall_code, elapsed_ticks, &sectors))
+    {
+        case HALL_RESYNC_MISSED_EDGE:
+            restart_speed_timer(wrapped);
+            sector_ticks = hall_speed_udiv(elapsed_ticks, sectors);
+            sector_interpolated = true;
+            /* Each interpolated sector ends with the code of its own sequence
+             * step: the skipped code after the sectors of the previous one */
+            code_sectors = hall_placement_get_span(sector_code);
+            while (sectors-- > 0U)
+            {
+                if (--code_sectors == 0U)
+                {
+                    sector_code = hall_resync_get_next_code(sector_code);
+                    code_sectors = hall_placement_get_span(sector_code);
+                }
+                process_sector_time(sector_ticks, sector_code);
+            }
+            sector_interpolated = false;
+            hall_resync_edge(hall_code, sector_ticks);
+            HALL_HEALTH_COUNT(HALL_HEALTH_RESYNC);
+            break;
+
+        case HALL_RESYNC_LOST:
+            restart_speed_timer(wrapped);
+            /* Without the edge time the next capture covers a partial sector */
+            first_capture_pending = !edge_seen;
+            #if ENABLE_KALMAN_ESTIMATOR
+            hall_kalman_init();
+            #endif
+            HALL_HEALTH_COUNT(HALL_HEALTH_RESYNC);
+            break;
+
+        default:
+            /* Glitch: the current sector continues, a wrap of the speed timer
+             * is left to the next capture */
+            hall_code = hall_resync_get_code();
+            HALL_HEALTH_COUNT(HALL_HEALTH_GLITCH);
+            break;
+    }
+
+    #if (HALL_SENSOR_PLACEMENT == HALL_PLACEMENT_TWO_SENSOR)
+    hall_sector_code = hall_code;
+    #endif
+
+    /* Configure current and expected hall patterns */
+    XMC_POSIF_HSC_SetHallPatterns(HALL_POSIF_HW, hall_patterns[hall_code]);
+    XMC_POSIF_HSC_UpdateHallPattern(HALL_POSIF_HW);
+
+    __set_PRIMASK(primask);
+}
+#endif
+
 /*******************************************************************************
 * Function Name: POSIF0_0_IRQHandler
 ********************************************************************************
@@ -152,13 +1028,16 @@ void SysTick_Handler(void)
 void POSIF0_0_IRQHandler(void)
 {
     /* Get the capture timer value */
-    uint16_t captured_value = 0;
+    uint32_t captured_value = 0;
+    bool wrapped;
 
     /* Set che_flag to 1 */
     che_flag = 1;
     /* Set whe_flag to 0 */
     whe_flag = 0;
 
+    HALL_HEALTH_COUNT(HALL_HEALTH_CHE);
+
     /* Check for a rising edge of POSIF0.OUT1 signal */
     if (XMC_CCU4_SLICE_GetEvent(HALL_SPEED_TIMER_HW, XMC_CCU4_SLICE_IRQ_ID_EVENT0))
     {
@@ -168,9 +1047,64 @@ void POSIF0_0_IRQHandler(void)
         /* Get captured timer value on rising edge */
         captured_value = XMC_CCU4_SLICE_GetCaptureRegisterValue(HALL_SPEED_TIMER_HW, 1U);
 
-        /* Calculate the time between two correct hall events
-         * (captured_value * prescaler * 1000) / clock */
-        hall_events_interval = captured_value * HALL_SPEED_TIMER_TICK_NS;
+        /* A period match since the last capture means the 16-bit timer wrapped
+         * and the captured value is not the full sector time */
+        wrapped = XMC_CCU4_SLICE_GetEvent(HALL_SPEED_TIMER_HW, XMC_CCU4_SLICE_IRQ_ID_PERIOD_MATCH);
+
+        #if ENABLE_SPEED_TRIP
+        /* Check a full sector time against the upper speed limit */
+        (void)hall_trip_check_capture(!wrapped && !first_capture_pending &&
+                                      ((captured_value & CCU4_CC4_CV_FFL_Msk) != 0U));
+        #endif
+
+        if (wrapped)
+        {
+            XMC_CCU4_SLICE_ClearEvent(HALL_SPEED_TIMER_HW, XMC_CCU4_SLICE_IRQ_ID_PERIOD_MATCH);
+            speed_timer_overflows++;
+            HALL_HEALTH_COUNT(HALL_HEALTH_STALL);
+
+            #if ENABLE_KALMAN_ESTIMATOR
+            /* The sector time sequence has a gap */
+            hall_kalman_init();
+            #endif
+        }
+        /* Only use the value if the capture register holds a new capture */
+        else if ((captured_value & CCU4_CC4_CV_FFL_Msk) != 0U)
+        {
+            #if (HALL_SENSOR_PLACEMENT == HALL_PLACEMENT_TWO_SENSOR)
+            /* A code covering two sectors is passed on as two sector times. The
+             * partial first capture is left whole for process_sector_time()
+             * to discard */
+            uint32_t sector_ticks = captured_value & CCU4_CC4_CV_CAPTV_Msk;
+
+            if (!first_capture_pending && (hall_placement_get_span(hall_sector_code) > 1U))
+            {
+                sector_ticks >>= 1U;
+                process_sector_time(sector_ticks, hall_sector_code);
+            }
+            process_sector_time(sector_ticks, (uint8_t)XMC_POSIF_HSC_GetLastSampledPattern(HALL_POSIF_HW));
+            #else
+            process_sector_time(captured_value & CCU4_CC4_CV_CAPTV_Msk,
+                                (uint8_t)XMC_POSIF_HSC_GetLastSampledPattern(HALL_POSIF_HW));
+            #endif
+        }
+        #if (HALL_SENSOR_PLACEMENT == HALL_PLACEMENT_TWO_SENSOR)
+        hall_sector_code = (uint8_t)XMC_POSIF_HSC_GetLastSampledPattern(HALL_POSIF_HW);
+        #endif
+
+        #if ENABLE_ORDER_TRACKING
+        /* Tie the profile slot to the rotor position of the new code */
+        {
+            uint8_t hall_code = (uint8_t)XMC_POSIF_HSC_GetLastSampledPattern(HALL_POSIF_HW);
+
+            hall_order_set_code(hall_placement_to_canonical(hall_code), hall_placement_get_span(hall_code));
+        }
+        #endif
+
+        #if ENABLE_HALL_RESYNC
+        /* Base the next edge prediction on the new sector time */
+        hall_resync_edge((uint8_t)XMC_POSIF_HSC_GetLastSampledPattern(HALL_POSIF_HW), hall_events_ticks);
+        #endif
     }
     /* Clear pending event */
     XMC_POSIF_ClearEvent(HALL_POSIF_HW, XMC_POSIF_IRQ_EVENT_CHE);
@@ -191,16 +1125,91 @@ void POSIF0_0_IRQHandler(void)
 *
 *******************************************************************************/
 void POSIF0_1_IRQHandler(void)
+{
+    #if ENABLE_WHE_STORM_LIMIT
+    /* Mask the interrupt when the wrong hall events exceed the rate limit */
+    if (!hall_storm_event())
+    {
+        XMC_POSIF_DisableEvent(HALL_POSIF_HW, XMC_POSIF_IRQ_EVENT_WHE);
+    }
+    #endif
+
+    handle_wrong_hall_event(true);
+
+    /* Clear pending event */
+    XMC_POSIF_ClearEvent(HALL_POSIF_HW, XMC_POSIF_IRQ_EVENT_WHE);
+}
+
+/*******************************************************************************
+* Function Name: handle_wrong_hall_event
+********************************************************************************
+* Summary:
+*  Handles wrong hall events, either from their interrupt or, while the
+*  interrupt is masked during a storm, polled by the SysTick handler.
+*
+* Parameters:
+*  at_edge: true if called from the interrupt at the edge
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void handle_wrong_hall_event(bool at_edge)
 {
     /* Set whe_flag to 1 */
     whe_flag = 1;
     /* Set che_flag to 0 */
     che_flag = 0;
 
-    /* Clear pending event */
-    XMC_POSIF_ClearEvent(HALL_POSIF_HW, XMC_POSIF_IRQ_EVENT_WHE);
+    HALL_HEALTH_COUNT(HALL_HEALTH_WHE);
+
+    #if ENABLE_EDGE_STREAM
+    /* Mark the wrong hall event in the edge stream */
+    hall_stream_push_whe();
+    #endif
+
+    #if ENABLE_ORDER_TRACKING
+    /* The profile may contain sector times of the wrong slots */
+    hall_order_reset();
+    #endif
+
+    #if ENABLE_HALL_DUTY_MONITOR
+    /* The running period contains an invalid pattern */
+    hall_duty_restart_period();
+    #endif
+
+    #if ENABLE_HALL_RESYNC
+    /* Follow the hall inputs instead of waiting for the main loop */
+    if (timers_started)
+    {
+        resync_hall_state(at_edge ? RESYNC_AT_EDGE : RESYNC_POLLED);
+    }
+    #else
+    (void)at_edge;
+    #endif
 }
 
+#if ENABLE_SPEED_TRIP
+/*******************************************************************************
+* Function Name: HALL_TRIP_IRQHandler
+********************************************************************************
+* Summary:
+*  Interrupt handler of the speed timer period match, which occurs when a
+*  sector lasts longer than the underspeed limit.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void HALL_TRIP_IRQHandler(void)
+{
+    hall_trip_underspeed();
+}
+#endif
+
 /*******************************************************************************
 * Function Name: main
 ********************************************************************************
@@ -222,15 +1231,70 @@ int main(void)
 {
     cy_rslt_t result;
 
+    #if ENABLE_BOOT_PROFILE
+    /* The SysTick timer is the time base of the boot profile, so it is started
+     * first and not reconfigured below */
+    SysTick_Config(SystemCoreClock / TICKS_PER_SECOND);
+    #endif
+
     /* Initialize the device and board peripherals */
     result = cybsp_init();
     if (result != CY_RSLT_SUCCESS)
     {
         CY_ASSERT(0);
     }
+    BOOT_PROFILE_MARK(BOOT_PHASE_CYBSP_INIT);
+
+    #if (HALL_SENSOR_PLACEMENT == HALL_PLACEMENT_120)
+    /* Use the hall sequence configured in the POSIF personality */
+    for (uint32_t i = 0; i < 8U; i++)
+    {
+        hall_patterns[i] = (uint8_t)HALL_POSIF_Hall_Pattern[i];
+    }
+    #else
+    /* Use the hall sequence of the selected sensor placement */
+    hall_placement_get_patterns(hall_patterns);
+    #endif
+
+    /* Initialize the speed and angle calculation backend */
+    hall_speed_init();
+
+    /* Prepare the hall input sampling */
+    hall_input_init();
+
+    #if ENABLE_SPEED_TRIP
+    /* Program the speed limits into the speed timer */
+    hall_trip_init();
+    #endif
+
+    #if ENABLE_CMSIS_DSP_FILTER
+    /* Reset the sector time filter */
+    hall_filter_init();
+    #endif
+
+    #if ENABLE_KALMAN_ESTIMATOR
+    /* Reset the speed estimator */
+    hall_kalman_init();
+    #endif
+
+    #if ENABLE_SPEED_SPECTRUM
+    /* Prepare the speed ripple FFT */
+    hall_spectrum_init();
+    #endif
+
+    #if ENABLE_HALL_DUTY_MONITOR
+    /* Clear the hall sensor duty cycle statistics */
+    hall_duty_reset();
+    #endif
+
+    #if ENABLE_WHE_STORM_LIMIT
+    /* Fill the rate limit and start counting the masked wrong hall events */
+    hall_storm_init();
+    #endif
 
     /* Initialize retarget-io to use the debug UART port */
     cy_retarget_io_init(CYBSP_DEBUG_UART_HW);
+    BOOT_PROFILE_MARK(BOOT_PHASE_RETARGET_IO);
 
     #if ENABLE_XMC_DEBUG_PRINT
     printf("Initialization done\r\n");
@@ -242,71 +1306,179 @@ int main(void)
     printf("============================================================ \r\n");
     #endif
 
+    #if ENABLE_COMMAND_SHELL
+    /* Accept commands on the debug UART */
+    hall_shell_init();
+    #endif
 
     /* Set priority */
     NVIC_SetPriority(POSIF0_0_IRQn, 0U);
     NVIC_SetPriority(POSIF0_1_IRQn, 1U);
 
     /* Enable IRQ */
+    #if ENABLE_CAPTURE_FIFO
+    {
+        /* Captures are collected from the FIFO in the SysTick handler. The
+         * speed timer settings of design.modus, with extended capture mode
+         * and full capture registers kept unchanged */
+        const XMC_CCU4_SLICE_CAPTURE_CONFIG_t capture_fifo_config =
+        {
+            .fifo_enable = 1U,
+            .timer_clear_mode = (uint32_t)XMC_CCU4_SLICE_TIMER_CLEAR_MODE_CAP_LOW,
+            .same_event = 0U,
+            .ignore_full_flag = 0U,
+            .prescaler_mode = (uint32_t)XMC_CCU4_SLICE_PRESCALER_MODE_NORMAL,
+            .prescaler_initval = (uint32_t)XMC_CCU4_SLICE_PRESCALER_512,
+            .float_limit = (uint32_t)XMC_CCU4_SLICE_PRESCALER_32768,
+            .timer_concatenation = 0U
+        };
+
+        XMC_CCU4_SLICE_CaptureInit(HALL_SPEED_TIMER_HW, &capture_fifo_config);
+    }
+    #else
     NVIC_EnableIRQ(POSIF0_0_IRQn);
+    #endif
     NVIC_EnableIRQ(POSIF0_1_IRQn);
+    #if ENABLE_SPEED_TRIP
+    NVIC_SetPriority(HALL_TRIP_IRQn, 0U);
+    NVIC_EnableIRQ(HALL_TRIP_IRQn);
+    #endif
+    BOOT_PROFILE_MARK(BOOT_PHASE_NVIC);
 
+    #if !ENABLE_BOOT_PROFILE
     /* Print the CHE/WHE occurrence for every 500ms */
     SysTick_Config(SystemCoreClock / TICKS_PER_SECOND);
+    #else
+    /* Start the reports of the SysTick timer that is already running */
+    systick_ready = true;
+    #endif
+    BENCHMARK_RUN();
+
+    #if (HALL_SENSOR_PLACEMENT != HALL_PLACEMENT_120)
+    /* Simulate the hall signals of the selected sensor placement */
+    configure_hall_simulation();
+    #endif
 
     /* Start HALL_1, HALL_2 and HALL_3 Timers */
     XMC_CCU8_SLICE_StartTimer(HALL_1_HW);
     XMC_CCU8_SLICE_StartTimer(HALL_2_HW);
     XMC_CCU8_SLICE_StartTimer(HALL_3_HW);
+    BOOT_PROFILE_MARK(BOOT_PHASE_TIMERS);
 
     while (1)
     {
         XMC_Delay(1);
+
+        #if ENABLE_COMMAND_SHELL
+        /* Run the commands received on the debug UART */
+        hall_shell_poll();
+        #endif
+
+        #if ENABLE_HALL_AUTO_DETECT
+        /* Observe the hall inputs until the sequence is known */
+        if (!hall_sequence_detected)
+        {
+            hall_position = hall_input_read();
+
+            if (hall_detect_sample(hall_position) == HALL_DETECT_DONE)
+            {
+                uint8_t sequence[6];
+
+                hall_detect_get_patterns(hall_patterns);
+                hall_detect_get_sequence(sequence);
+                printf("Detected hall sequence %u-%u-%u-%u-%u-%u (%s)\r\n",
+                        sequence[0], sequence[1], sequence[2], sequence[3], sequence[4], sequence[5],
+                        (hall_detect_get_direction() == HALL_DETECT_FORWARD) ? "forward" : "reverse");
+                hall_angle_set_sequence(sequence);
+                hall_sequence_detected = true;
+            }
+            continue;
+        }
+        #endif
+
+        #if !ENABLE_FAST_STARTUP
         /* Checks if period match event has occurred */
         if (XMC_CCU8_SLICE_GetEvent(HALL_3_HW, XMC_CCU8_SLICE_IRQ_ID_PERIOD_MATCH))
         {
             /* Timers are not started and CCU8 pulse counter greater than 3 */
             if ((ccu8_pulse_counter++ > 3) && (!timers_started))
             {
-                /* Start the Encoder */
-                XMC_POSIF_Start(HALL_POSIF_HW);
-
-                /* Read the Hall input GPIO pins */
-                hall[0] = XMC_GPIO_GetInput(HALL_INPUT_1_PORT, HALL_INPUT_1_PIN);
-                hall[1] = XMC_GPIO_GetInput(HALL_INPUT_2_PORT, HALL_INPUT_2_PIN);
-                hall[2] = XMC_GPIO_GetInput(HALL_INPUT_3_PORT, HALL_INPUT_3_PIN);
-                hall_position = (uint8_t)((hall[0] | (hall[1] << 1) | (hall[2] << 2)));
-
-                /* Configure current and expected hall patterns */
-                XMC_POSIF_HSC_SetHallPatterns(HALL_POSIF_HW, HALL_POSIF_Hall_Pattern[hall_position ? hall_position : 1]);
-
-                /* Update hall pattern */
-                XMC_POSIF_HSC_UpdateHallPattern(HALL_POSIF_HW);
-
-                /* Start CCU4 timers */
-                XMC_CCU4_SLICE_StartTimer(HALL_DELAY_TIMER_HW);
-                XMC_CCU4_SLICE_StartTimer(HALL_SPEED_TIMER_HW);
-
-                /* Sets the timers flag to the true value */
-                timers_started = true;
+                start_hall_capture();
             }
             XMC_CCU8_SLICE_ClearEvent(HALL_3_HW, XMC_CCU8_SLICE_IRQ_ID_PERIOD_MATCH);
         }
+        #else
+        /* Start as soon as the hall inputs show a valid pattern */
+        if (!timers_started)
+        {
+            hall_position = hall_input_read();
+
+            if (hall_placement_is_valid(hall_position))
+            {
+                start_hall_capture();
+            }
+        }
+        #endif
 
         /* Delay and Speed timers are started */
         if (timers_started)
         {
             /* Read the Hall input GPIO pins */
-            hall[0] = XMC_GPIO_GetInput(HALL_INPUT_1_PORT, HALL_INPUT_1_PIN);
-            hall[1] = XMC_GPIO_GetInput(HALL_INPUT_2_PORT, HALL_INPUT_2_PIN);
-            hall[2] = XMC_GPIO_GetInput(HALL_INPUT_3_PORT, HALL_INPUT_3_PIN);
-            hall_position = (uint8_t)((hall[0] | (hall[1] << 1) | (hall[2] << 2)));
+            hall_position = hall_input_read();
+
+            #if ENABLE_MATH_COPROCESSOR
+            /* Interpolate the electrical angle and start its sine calculation */
+            #if ENABLE_KALMAN_ESTIMATOR
+            {
+                /* Predict the sector in progress from the time elapsed in it */
+                uint32_t elapsed_ticks = XMC_CCU4_SLICE_GetTimerValue(HALL_SPEED_TIMER_HW);
+
+                hall_electrical_angle = hall_angle_get(hall_placement_to_canonical(hall_position),
+                        elapsed_ticks, hall_kalman_predict(elapsed_ticks));
+            }
+            #else
+            hall_electrical_angle = hall_angle_get(hall_placement_to_canonical(hall_position),
+                    XMC_CCU4_SLICE_GetTimerValue(HALL_SPEED_TIMER_HW), hall_events_ticks);
+            #endif
+            hall_angle_start_sin(hall_electrical_angle);
+            #endif
 
             /* Configure current and expected hall patterns */
-            XMC_POSIF_HSC_SetHallPatterns(HALL_POSIF_HW, HALL_POSIF_Hall_Pattern[hall_position ? hall_position : 1]);
+            XMC_POSIF_HSC_SetHallPatterns(HALL_POSIF_HW, hall_patterns[hall_placement_is_valid(hall_position) ?
+            hall_position : hall_placement_get_first_code()]);
 
             /* Update hall pattern */
             XMC_POSIF_HSC_UpdateHallPattern(HALL_POSIF_HW);
+
+            #if ENABLE_MATH_COPROCESSOR
+            /* The sine was calculated while the hall pattern was updated */
+            hall_electrical_sine = hall_angle_read_sin();
+            #endif
+
+            #if ENABLE_EDGE_BUFFER
+            {
+                /* Process all sector times captured since the last iteration */
+                uint32_t block[EDGE_BLOCK_SIZE];
+                uint32_t count = hall_edge_buffer_read(block, EDGE_BLOCK_SIZE);
+
+                if (count != 0U)
+                {
+                    #if ENABLE_SPEED_SPECTRUM
+                    (void)hall_spectrum_process(block, count);
+                    #endif
+
+                    #if ENABLE_CMSIS_DSP_FILTER
+                    /* Only the decimated sector times are converted to rpm */
+                    count = hall_filter_process(block, block, count);
+                    if (count != 0U)
+                    {
+                        hall_filtered_ticks = block[count - 1U];
+                        hall_filtered_rpm = hall_speed_get_rpm(hall_filtered_ticks);
+                    }
+                    #endif
+                }
+            }
+            #endif
         }
     }
 }
@@ -0,0 +1,248 @@
+/*******************************************************************************
+* File Name:   arm_math.c
+*
+* Description: Host replacement of the CMSIS-DSP functions used by the example,
+*              following the generic C reference implementation of the library.
+*              The FFT is a direct DFT.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "arm_math.h"
+#include <math.h>
+#include <string.h>
+
+/*******************************************************************************
+* Function Name: arm_biquad_cascade_df1_init_q31
+********************************************************************************
+* Summary:
+*  Initialises a Q31 biquad cascade and clears its state.
+*
+*******************************************************************************/
+void arm_biquad_cascade_df1_init_q31(arm_biquad_casd_df1_inst_q31 *S, uint8_t numStages,
+                                     const q31_t *pCoeffs, q31_t *pState, int8_t postShift)
+{
+    S->numStages = numStages;
+    S->pCoeffs = pCoeffs;
+    S->postShift = (uint8_t)postShift;
+    S->pState = pState;
+    memset(pState, 0, 4U * numStages * sizeof(q31_t));
+}
+
+/*******************************************************************************
+* Function Name: arm_biquad_cascade_df1_q31
+********************************************************************************
+* Summary:
+*  Q31 biquad cascade in direct form I with 64-bit accumulation. Each stage
+*  shifts its accumulator right by 31 - postShift, truncating.
+*
+*******************************************************************************/
+void arm_biquad_cascade_df1_q31(const arm_biquad_casd_df1_inst_q31 *S, const q31_t *pSrc,
+                                q31_t *pDst, uint32_t blockSize)
+{
+    const q31_t *pIn = pSrc;
+    const q31_t *pCoeffs = S->pCoeffs;
+    q31_t *pState = S->pState;
+    uint32_t lShift = 32U - ((uint32_t)S->postShift + 1U);
+    uint32_t stage = S->numStages;
+    uint32_t sample;
+    q31_t b0, b1, b2, a1, a2;
+    q31_t Xn1, Xn2, Yn1, Yn2;
+    q31_t Xn;
+    q63_t acc;
+
+    do
+    {
+        b0 = *pCoeffs++;
+        b1 = *pCoeffs++;
+        b2 = *pCoeffs++;
+        a1 = *pCoeffs++;
+        a2 = *pCoeffs++;
+
+        Xn1 = pState[0];
+        Xn2 = pState[1];
+        Yn1 = pState[2];
+        Yn2 = pState[3];
+
+        for (sample = 0U; sample < blockSize; sample++)
+        {
+            Xn = pIn[sample];
+
+            acc = (q63_t)b0 * Xn;
+            acc += (q63_t)b1 * Xn1;
+            acc += (q63_t)b2 * Xn2;
+            acc += (q63_t)a1 * Yn1;
+            acc += (q63_t)a2 * Yn2;
+
+            Xn2 = Xn1;
+            Xn1 = Xn;
+            Yn2 = Yn1;
+            Yn1 = (q31_t)(acc >> lShift);
+            pDst[sample] = Yn1;
+        }
+
+        /* The output of a stage is the input of the next one */
+        pIn = pDst;
+
+        *pState++ = Xn1;
+        *pState++ = Xn2;
+        *pState++ = Yn1;
+        *pState++ = Yn2;
+    } while (--stage > 0U);
+}
+
+/*******************************************************************************
+* Function Name: arm_rfft_fast_init_f32
+********************************************************************************
+* Summary:
+*  Initialises a real FFT of fftLen points.
+*
+*******************************************************************************/
+arm_status arm_rfft_fast_init_f32(arm_rfft_fast_instance_f32 *S, uint16_t fftLen)
+{
+    S->fftLenRFFT = fftLen;
+
+    return ARM_MATH_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: arm_rfft_fast_f32
+********************************************************************************
+* Summary:
+*  Forward real FFT, computed as a direct DFT in double precision. The output
+*  is packed like the library: pOut[0] is the DC value, pOut[1] the real
+*  Nyquist value, and pOut[2k], pOut[2k + 1] the real and imaginary parts of
+*  bin k. Only the forward transform is provided.
+*
+*******************************************************************************/
+void arm_rfft_fast_f32(const arm_rfft_fast_instance_f32 *S, float32_t *p, float32_t *pOut, uint8_t ifftFlag)
+{
+    uint32_t n = S->fftLenRFFT;
+    uint32_t k;
+    uint32_t i;
+    double re;
+    double im;
+
+    (void)ifftFlag;
+
+    for (k = 0U; k <= (n / 2U); k++)
+    {
+        re = 0.0;
+        im = 0.0;
+        for (i = 0U; i < n; i++)
+        {
+            re += p[i] * cos((2.0 * M_PI * k * i) / n);
+            im -= p[i] * sin((2.0 * M_PI * k * i) / n);
+        }
+        if (k == 0U)
+        {
+            pOut[0] = (float32_t)re;
+        }
+        else if (k == (n / 2U))
+        {
+            pOut[1] = (float32_t)re;
+        }
+        else
+        {
+            pOut[2U * k] = (float32_t)re;
+            pOut[(2U * k) + 1U] = (float32_t)im;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: arm_mean_f32, arm_offset_f32, arm_mult_f32
+********************************************************************************
+* Summary:
+*  Element-wise vector functions.
+*
+*******************************************************************************/
+void arm_mean_f32(const float32_t *pSrc, uint32_t blockSize, float32_t *pResult)
+{
+    float32_t sum = 0.0f;
+    uint32_t i;
+
+    for (i = 0U; i < blockSize; i++)
+    {
+        sum += pSrc[i];
+    }
+    *pResult = sum / (float32_t)blockSize;
+}
+
+void arm_offset_f32(const float32_t *pSrc, float32_t offset, float32_t *pDst, uint32_t blockSize)
+{
+    uint32_t i;
+
+    for (i = 0U; i < blockSize; i++)
+    {
+        pDst[i] = pSrc[i] + offset;
+    }
+}
+
+void arm_mult_f32(const float32_t *pSrcA, const float32_t *pSrcB, float32_t *pDst, uint32_t blockSize)
+{
+    uint32_t i;
+
+    for (i = 0U; i < blockSize; i++)
+    {
+        pDst[i] = pSrcA[i] * pSrcB[i];
+    }
+}
+
+/*******************************************************************************
+* Function Name: arm_sqrt_f32, arm_sin_f32, arm_cos_f32
+********************************************************************************
+* Summary:
+*  Scalar functions, computed with the C library.
+*
+*******************************************************************************/
+arm_status arm_sqrt_f32(float32_t in, float32_t *pOut)
+{
+    if (in < 0.0f)
+    {
+        *pOut = 0.0f;
+        return ARM_MATH_ARGUMENT_ERROR;
+    }
+    *pOut = sqrtf(in);
+
+    return ARM_MATH_SUCCESS;
+}
+
+float32_t arm_sin_f32(float32_t x)
+{
+    return sinf(x);
+}
+
+float32_t arm_cos_f32(float32_t x)
+{
+    return cosf(x);
+}
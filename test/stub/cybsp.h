@@ -0,0 +1,81 @@
+/*******************************************************************************
+* File Name:   cybsp.h
+*
+* Description: Host replacement of the board support header for the unit
+*              tests. Provides only what the modules under test use; the
+*              hardware accessors are implemented by the tests that need them.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#ifndef CYBSP_H_
+#define CYBSP_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+#define XMC1                                (1)
+#define XMC4                                (4)
+
+/* Tests build for the Cortex-M0 devices unless they select another family */
+#ifndef UC_FAMILY
+#define UC_FAMILY                           (XMC1)
+#endif
+
+/* Speed timer tick of the example: 64 MHz / 512 */
+#define HALL_SPEED_TIMER_TICK_NS            (8000U)
+
+/*******************************************************************************
+* Function Name: __get_PRIMASK, __disable_irq, __set_PRIMASK
+********************************************************************************
+* Summary:
+*  The tests run single-threaded, so critical sections do nothing.
+*
+*******************************************************************************/
+static inline uint32_t __get_PRIMASK(void)
+{
+    return 0U;
+}
+
+static inline void __disable_irq(void)
+{
+}
+
+static inline void __set_PRIMASK(uint32_t primask)
+{
+    (void)primask;
+}
+
+#endif /* CYBSP_H_ */
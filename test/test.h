@@ -0,0 +1,114 @@
+/*******************************************************************************
+* File Name:   test.h
+*
+* Description: Minimal check and report helpers of the host unit tests.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#ifndef TEST_H_
+#define TEST_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Records a failed check without stopping the test */
+#define TEST_CHECK(condition)               test_check((condition), #condition, __FILE__, __LINE__)
+
+/* Number of failed checks printed in detail */
+#define TEST_MAX_REPORTED                   (20U)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static uint32_t test_failures = 0U;
+
+/*******************************************************************************
+* Function Name: test_check
+********************************************************************************
+* Summary:
+*  Counts a failed check and prints the first TEST_MAX_REPORTED of them.
+*
+* Parameters:
+*  passed: result of the check
+*  condition: text of the checked condition
+*  file: source file of the check
+*  line: source line of the check
+*
+* Return:
+*  bool: the result of the check
+*
+*******************************************************************************/
+static inline bool test_check(bool passed, const char *condition, const char *file, int line)
+{
+    if (!passed)
+    {
+        if (test_failures < TEST_MAX_REPORTED)
+        {
+            printf("%s:%d: check failed: %s\n", file, line, condition);
+        }
+        test_failures++;
+    }
+
+    return passed;
+}
+
+/*******************************************************************************
+* Function Name: test_result
+********************************************************************************
+* Summary:
+*  Prints the outcome of a test program.
+*
+* Parameters:
+*  name: name of the test program
+*
+* Return:
+*  int: exit status, 0 if all checks passed
+*
+*******************************************************************************/
+static inline int test_result(const char *name)
+{
+    if (test_failures != 0U)
+    {
+        printf("%s: %lu checks FAILED\n", name, (unsigned long)test_failures);
+        return 1;
+    }
+
+    printf("%s: passed\n", name);
+    return 0;
+}
+
+#endif /* TEST_H_ */
@@ -0,0 +1,248 @@
+/*******************************************************************************
+* File Name:   test_hall_detect.c
+*
+* Description: Host test of the hall sequence detection for every wiring order of
+*              the three hall inputs in both directions of rotation.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "cybsp.h"
+#include "hall_detect.h"
+#include "test.h"
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Samples taken of every hall position, as the main loop samples faster than
+ * the positions change */
+#define TEST_SAMPLES_PER_POSITION           (3U)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* Hall positions of the motor in forward direction with the wiring of the
+ * example */
+static const uint8_t test_forward[6] = { 1U, 3U, 2U, 6U, 4U, 5U };
+
+/* Input of the motor sensor wired to each hall input, for all wiring orders */
+static const uint8_t test_wirings[6][3] =
+{
+    { 0U, 1U, 2U }, { 0U, 2U, 1U }, { 1U, 0U, 2U },
+    { 1U, 2U, 0U }, { 2U, 0U, 1U }, { 2U, 1U, 0U }
+};
+
+/*******************************************************************************
+* Function Name: test_wire
+********************************************************************************
+* Summary:
+*  Returns the hall position read through a wiring order.
+*
+* Parameters:
+*  position: hall position of the motor sensors
+*  wiring: sensor wired to each hall input
+*
+* Return:
+*  uint8_t: hall position at the inputs
+*
+*******************************************************************************/
+static uint8_t test_wire(uint8_t position, const uint8_t *wiring)
+{
+    uint8_t wired = 0U;
+    uint32_t i;
+
+    for (i = 0U; i < 3U; i++)
+    {
+        wired |= (uint8_t)(((position >> wiring[i]) & 1U) << i);
+    }
+
+    return wired;
+}
+
+/*******************************************************************************
+* Function Name: test_is_forward
+********************************************************************************
+* Summary:
+*  Checks whether every transition of a sequence is one of the forward
+*  sequence 1 -> 3 -> 2 -> 6 -> 4 -> 5.
+*
+* Parameters:
+*  sequence: six hall positions in the order of rotation
+*
+* Return:
+*  bool: true for the forward sequence
+*
+*******************************************************************************/
+static bool test_is_forward(const uint8_t *sequence)
+{
+    uint32_t i;
+    uint32_t j;
+
+    for (i = 0U; i < 6U; i++)
+    {
+        for (j = 0U; (j < 6U) && (test_forward[j] != sequence[i]); j++)
+        {
+        }
+        if (test_forward[(j + 1U) % 6U] != sequence[(i + 1U) % 6U])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: test_detect
+********************************************************************************
+* Summary:
+*  Turns the motor from every start position through one wiring order and
+*  checks that the detection completes after exactly HALL_DETECT_TRANSITIONS
+*  transitions with the sequence, patterns, and direction of the inputs.
+*
+* Parameters:
+*  wiring: sensor wired to each hall input
+*  reverse: direction of rotation of the motor
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_detect(const uint8_t *wiring, bool reverse)
+{
+    uint8_t inputs[6];
+    uint8_t sequence[6];
+    uint8_t patterns[8];
+    hall_detect_status_t status;
+    uint32_t transitions;
+    uint32_t start;
+    uint32_t step;
+    uint32_t i;
+
+    /* Hall positions at the inputs in the order the motor produces them */
+    for (i = 0U; i < 6U; i++)
+    {
+        inputs[i] = test_wire(test_forward[reverse ? ((6U - i) % 6U) : i], wiring);
+    }
+
+    for (start = 0U; start < 6U; start++)
+    {
+        hall_detect_reset();
+        status = HALL_DETECT_BUSY;
+        transitions = 0U;
+
+        for (step = 0U; (step <= HALL_DETECT_TRANSITIONS) && (status == HALL_DETECT_BUSY); step++)
+        {
+            for (i = 0U; (i < TEST_SAMPLES_PER_POSITION) && (status == HALL_DETECT_BUSY); i++)
+            {
+                status = hall_detect_sample(inputs[(start + step) % 6U]);
+            }
+            transitions = step;
+        }
+        TEST_CHECK(status == HALL_DETECT_DONE);
+        TEST_CHECK(transitions == HALL_DETECT_TRANSITIONS);
+
+        /* The detected sequence starts at position 1 and follows the inputs */
+        hall_detect_get_sequence(sequence);
+        for (i = 0U; (i < 6U) && (inputs[i] != 1U); i++)
+        {
+        }
+        for (step = 0U; step < 6U; step++)
+        {
+            TEST_CHECK(sequence[step] == inputs[(i + step) % 6U]);
+        }
+
+        hall_detect_get_patterns(patterns);
+        TEST_CHECK((patterns[0] == 0U) && (patterns[7] == 7U));
+        for (step = 0U; step < 6U; step++)
+        {
+            TEST_CHECK(patterns[inputs[step]] == (inputs[step] | (inputs[(step + 1U) % 6U] << 3U)));
+        }
+
+        TEST_CHECK(hall_detect_get_direction() ==
+                   (test_is_forward(inputs) ? HALL_DETECT_FORWARD : HALL_DETECT_REVERSE));
+    }
+}
+
+/*******************************************************************************
+* Function Name: test_reject
+********************************************************************************
+* Summary:
+*  Checks that invalid positions, jumps over a position, and a change of the
+*  direction restart the detection, and that it completes afterwards.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_reject(void)
+{
+    uint32_t i;
+
+    hall_detect_reset();
+    TEST_CHECK(hall_detect_sample(1U) == HALL_DETECT_BUSY);
+    TEST_CHECK(hall_detect_sample(7U) == HALL_DETECT_REJECTED);
+
+    /* 1 -> 2 skips position 3 and changes two inputs */
+    TEST_CHECK(hall_detect_sample(1U) == HALL_DETECT_BUSY);
+    TEST_CHECK(hall_detect_sample(2U) == HALL_DETECT_REJECTED);
+
+    /* 1 -> 3 -> 1 -> 5 turns back */
+    TEST_CHECK(hall_detect_sample(1U) == HALL_DETECT_BUSY);
+    TEST_CHECK(hall_detect_sample(3U) == HALL_DETECT_BUSY);
+    TEST_CHECK(hall_detect_sample(1U) == HALL_DETECT_BUSY);
+    TEST_CHECK(hall_detect_sample(5U) == HALL_DETECT_REJECTED);
+
+    for (i = 0U; i < HALL_DETECT_TRANSITIONS; i++)
+    {
+        TEST_CHECK(hall_detect_sample(test_forward[i % 6U]) == HALL_DETECT_BUSY);
+    }
+    TEST_CHECK(hall_detect_sample(test_forward[i % 6U]) == HALL_DETECT_DONE);
+    TEST_CHECK(hall_detect_get_direction() == HALL_DETECT_FORWARD);
+}
+
+int main(void)
+{
+    uint32_t wiring;
+
+    for (wiring = 0U; wiring < 6U; wiring++)
+    {
+        test_detect(test_wirings[wiring], false);
+        test_detect(test_wirings[wiring], true);
+    }
+    test_reject();
+
+    return test_result("test_hall_detect");
+}
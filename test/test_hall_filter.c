@@ -0,0 +1,182 @@
+/*******************************************************************************
+* File Name:   test_hall_filter.c
+*
+* Description: Host test of the sector time filter. Built for XMC4000, so that
+*              hall_filter_process() runs the CMSIS-DSP reference kernel, which
+*              is compared bit for bit with the C biquad used on XMC1000.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "cybsp.h"
+#include "hall_filter.h"
+#include "test.h"
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Sector times filtered per test sequence */
+#define TEST_SEQUENCE_LENGTH                (100000U)
+
+/* Shift of the sector times into the Q31 filter input, as in hall_filter.c */
+#define TEST_INPUT_SHIFT                    (14U)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static uint32_t test_random_state = 2463534242U;
+
+static uint32_t test_input[TEST_SEQUENCE_LENGTH];
+
+/*******************************************************************************
+* Function Name: test_random
+********************************************************************************
+* Summary:
+*  Returns the next value of a 32-bit xorshift generator.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t: pseudo random value
+*
+*******************************************************************************/
+static uint32_t test_random(void)
+{
+    test_random_state ^= test_random_state << 13;
+    test_random_state ^= test_random_state >> 17;
+    test_random_state ^= test_random_state << 5;
+
+    return test_random_state;
+}
+
+/*******************************************************************************
+* Function Name: test_sequence
+********************************************************************************
+* Summary:
+*  Filters test_input in blocks of random size with hall_filter_process() and
+*  with the C biquad followed by the decimation, and compares the outputs.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_sequence(void)
+{
+    int32_t state[HALL_FILTER_NUM_STATES] = { 0 };
+    uint32_t block[HALL_FILTER_BLOCK_SIZE];
+    int32_t expected;
+    uint32_t phase = 0U;
+    uint32_t position = 0U;
+    uint32_t outputs = 0U;
+    uint32_t count;
+    uint32_t written;
+    uint32_t i;
+
+    hall_filter_init();
+
+    while (position < TEST_SEQUENCE_LENGTH)
+    {
+        count = (test_random() % HALL_FILTER_BLOCK_SIZE) + 1U;
+        if (count > (TEST_SEQUENCE_LENGTH - position))
+        {
+            count = TEST_SEQUENCE_LENGTH - position;
+        }
+
+        for (i = 0U; i < count; i++)
+        {
+            block[i] = test_input[position + i];
+        }
+        written = hall_filter_process(block, block, count);
+
+        /* Every HALL_FILTER_DECIMATION-th C biquad output is kept */
+        for (i = 0U; i < count; i++)
+        {
+            expected = (int32_t)(test_input[position + i] << TEST_INPUT_SHIFT);
+            hall_filter_biquad_c(&expected, 1U, state);
+            if (phase == (HALL_FILTER_DECIMATION - 1U))
+            {
+                TEST_CHECK((outputs < written) &&
+                           (block[outputs] == ((expected > 0) ? ((uint32_t)expected >> TEST_INPUT_SHIFT) : 0U)));
+                outputs++;
+            }
+            phase = (phase + 1U) % HALL_FILTER_DECIMATION;
+        }
+        TEST_CHECK(outputs == written);
+
+        outputs = 0U;
+        position += count;
+    }
+}
+
+int main(void)
+{
+    uint32_t block[HALL_FILTER_BLOCK_SIZE];
+    uint32_t written;
+    uint32_t i;
+
+    /* Random sector times over the full 16-bit range of the speed timer */
+    for (i = 0U; i < TEST_SEQUENCE_LENGTH; i++)
+    {
+        test_input[i] = test_random() & 0xFFFFU;
+    }
+    test_sequence();
+
+    /* Speed steps between standstill and the top speed */
+    for (i = 0U; i < TEST_SEQUENCE_LENGTH; i++)
+    {
+        test_input[i] = (((i / 500U) & 1U) != 0U) ? 0xFFFFU : 3U;
+    }
+    test_sequence();
+
+    /* A constant sector time passes the filter unchanged, less one count of
+     * truncation */
+    hall_filter_init();
+    for (i = 0U; i < 64U; i++)
+    {
+        block[0] = 1000U;
+        block[1] = 1000U;
+        written = hall_filter_process(block, block, 2U);
+    }
+    TEST_CHECK(written <= 1U);
+    for (i = 0U; i < HALL_FILTER_DECIMATION; i++)
+    {
+        block[i] = 1000U;
+    }
+    written = hall_filter_process(block, block, HALL_FILTER_DECIMATION);
+    TEST_CHECK((written == 1U) && (block[0] >= 999U) && (block[0] <= 1000U));
+
+    return test_result("test_hall_filter");
+}
@@ -0,0 +1,243 @@
+/*******************************************************************************
+* File Name:   test_hall_health.c
+*
+* Description: Host test of the health monitor windows: an event leaves each window
+*              exactly when its bucket rolls out, and a steady event rate fills the
+*              windows to their length.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "cybsp.h"
+#include "hall_health.h"
+#include "test.h"
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Length of the windows and the lag of the 1 min and 1 h windows in ms */
+#define TEST_1S_MS                          (1000U)
+#define TEST_1MIN_MS                        (60000U)
+#define TEST_1H_MS                          (3600000U)
+#define TEST_1MIN_LAG_MS                    (100U)
+#define TEST_1H_LAG_MS                      (5000U)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* Milliseconds since the last reset */
+static uint32_t test_ms;
+
+/*******************************************************************************
+* Function Name: test_count
+********************************************************************************
+* Summary:
+*  Returns the count of an event type in a window.
+*
+* Parameters:
+*  window: window to read
+*  event: event type
+*
+* Return:
+*  uint32_t: count
+*
+*******************************************************************************/
+static uint32_t test_count(hall_health_window_t window, hall_health_event_t event)
+{
+    uint32_t counts[HALL_HEALTH_NUM_EVENTS];
+
+    hall_health_get_counts(window, counts);
+    return counts[event];
+}
+
+/*******************************************************************************
+* Function Name: test_advance_to
+********************************************************************************
+* Summary:
+*  Ticks the monitor every millisecond up to a time after the last reset.
+*
+* Parameters:
+*  ms: time to advance to
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_advance_to(uint32_t ms)
+{
+    while (test_ms < ms)
+    {
+        hall_health_tick();
+        test_ms++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: test_rollover
+********************************************************************************
+* Summary:
+*  Counts a single event and checks the time it enters and leaves each
+*  window. The 1 min and 1 h windows receive it when the bucket of the next
+*  finer window completes.
+*
+* Parameters:
+*  event: event type to count
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_rollover(hall_health_event_t event)
+{
+    hall_health_reset();
+    test_ms = 0U;
+    hall_health_event(event);
+
+    TEST_CHECK(test_count(HALL_HEALTH_WINDOW_1S, event) == 1U);
+    TEST_CHECK(test_count(HALL_HEALTH_WINDOW_1MIN, event) == 0U);
+
+    test_advance_to(TEST_1MIN_LAG_MS - 1U);
+    TEST_CHECK(test_count(HALL_HEALTH_WINDOW_1MIN, event) == 0U);
+    test_advance_to(TEST_1MIN_LAG_MS);
+    TEST_CHECK(test_count(HALL_HEALTH_WINDOW_1MIN, event) == 1U);
+
+    test_advance_to(TEST_1S_MS - 1U);
+    TEST_CHECK(test_count(HALL_HEALTH_WINDOW_1S, event) == 1U);
+    test_advance_to(TEST_1S_MS);
+    TEST_CHECK(test_count(HALL_HEALTH_WINDOW_1S, event) == 0U);
+
+    test_advance_to(TEST_1H_LAG_MS - 1U);
+    TEST_CHECK(test_count(HALL_HEALTH_WINDOW_1H, event) == 0U);
+    test_advance_to(TEST_1H_LAG_MS);
+    TEST_CHECK(test_count(HALL_HEALTH_WINDOW_1H, event) == 1U);
+
+    test_advance_to(TEST_1MIN_MS - 1U);
+    TEST_CHECK(test_count(HALL_HEALTH_WINDOW_1MIN, event) == 1U);
+    test_advance_to(TEST_1MIN_MS);
+    TEST_CHECK(test_count(HALL_HEALTH_WINDOW_1MIN, event) == 0U);
+
+    test_advance_to(TEST_1H_MS - 1U);
+    TEST_CHECK(test_count(HALL_HEALTH_WINDOW_1H, event) == 1U);
+    test_advance_to(TEST_1H_MS);
+    TEST_CHECK(test_count(HALL_HEALTH_WINDOW_1H, event) == 0U);
+}
+
+/*******************************************************************************
+* Function Name: test_steady_rate
+********************************************************************************
+* Summary:
+*  Counts one correct hall event every millisecond for two hours, so that
+*  every ring wraps around more than once. Right after a bucket of a window
+*  completes, the window holds all of its completed buckets, i.e. its length
+*  minus one bucket.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_steady_rate(void)
+{
+    hall_health_reset();
+    test_ms = 0U;
+
+    while (test_ms < (2U * TEST_1H_MS))
+    {
+        hall_health_event(HALL_HEALTH_CHE);
+        hall_health_tick();
+        test_ms++;
+
+        if ((test_ms >= TEST_1S_MS) && ((test_ms % TEST_1MIN_LAG_MS) == 0U))
+        {
+            TEST_CHECK(test_count(HALL_HEALTH_WINDOW_1S, HALL_HEALTH_CHE) == (TEST_1S_MS - TEST_1MIN_LAG_MS));
+        }
+        if ((test_ms >= TEST_1MIN_MS) && ((test_ms % TEST_1H_LAG_MS) == 0U))
+        {
+            TEST_CHECK(test_count(HALL_HEALTH_WINDOW_1MIN, HALL_HEALTH_CHE) == (TEST_1MIN_MS - TEST_1H_LAG_MS));
+        }
+        if ((test_ms >= TEST_1H_MS) && ((test_ms % TEST_1MIN_MS) == 0U))
+        {
+            TEST_CHECK(test_count(HALL_HEALTH_WINDOW_1H, HALL_HEALTH_CHE) == (TEST_1H_MS - TEST_1MIN_MS));
+        }
+    }
+
+    TEST_CHECK(hall_health_get_score(HALL_HEALTH_WINDOW_1H) == 100U);
+}
+
+/*******************************************************************************
+* Function Name: test_score
+********************************************************************************
+* Summary:
+*  Checks the weighted score and its rating at the thresholds.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_score(void)
+{
+    uint32_t i;
+
+    /* 90 correct and one wrong hall event score 90 of 100 */
+    hall_health_reset();
+    for (i = 0U; i < 90U; i++)
+    {
+        hall_health_event(HALL_HEALTH_CHE);
+    }
+    hall_health_event(HALL_HEALTH_WHE);
+    TEST_CHECK(hall_health_get_score(HALL_HEALTH_WINDOW_1S) == 90U);
+    TEST_CHECK(hall_health_get_score(HALL_HEALTH_WINDOW_1MIN) == 100U);
+
+    TEST_CHECK(hall_health_get_status(HALL_HEALTH_DEGRADED_SCORE) == HALL_HEALTH_OK);
+    TEST_CHECK(hall_health_get_status(HALL_HEALTH_DEGRADED_SCORE - 1U) == HALL_HEALTH_DEGRADED);
+    TEST_CHECK(hall_health_get_status(HALL_HEALTH_FAULT_SCORE) == HALL_HEALTH_DEGRADED);
+    TEST_CHECK(hall_health_get_status(HALL_HEALTH_FAULT_SCORE - 1U) == HALL_HEALTH_FAULT);
+}
+
+int main(void)
+{
+    uint32_t event;
+
+    for (event = 0U; event < HALL_HEALTH_NUM_EVENTS; event++)
+    {
+        test_rollover((hall_health_event_t)event);
+    }
+    test_steady_rate();
+    test_score();
+
+    return test_result("test_hall_health");
+}
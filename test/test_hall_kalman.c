@@ -0,0 +1,329 @@
+/*******************************************************************************
+* File Name:   test_hall_kalman.c
+*
+* Description: Replay harness of the Kalman speed estimator. Replays synthetic
+*              hall traces, or a recorded one given as a file of sector times,
+*              and compares the error and latency of the estimate with the raw
+*              captured sector times.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "cybsp.h"
+#include "hall_kalman.h"
+#include "test.h"
+#include <math.h>
+#include <stdlib.h>
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Sector times per synthetic trace */
+#define TEST_TRACE_LENGTH                   (4000U)
+
+/* Sector times skipped at the start of a trace while the estimate settles */
+#define TEST_SETTLE                         (200U)
+
+/* Largest latency searched, in sectors */
+#define TEST_MAX_LATENCY                    (16U)
+
+/* Sector times averaged on each side for the reference of a recorded trace */
+#define TEST_REFERENCE_SPAN                 (7U)
+
+/*******************************************************************************
+* Data structure and enumeration
+*******************************************************************************/
+typedef struct
+{
+    double rms;         /* RMS error against the true sector time in ticks */
+    uint32_t latency;   /* Delay in sectors that best aligns it with the truth */
+} test_score_t;
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static uint32_t test_random_state = 88172645U;
+
+static uint32_t test_measured[TEST_TRACE_LENGTH];
+static double test_truth[TEST_TRACE_LENGTH];
+static double test_estimate[TEST_TRACE_LENGTH];
+static double test_raw[TEST_TRACE_LENGTH];
+
+/*******************************************************************************
+* Function Name: test_random_jitter
+********************************************************************************
+* Summary:
+*  Returns a uniformly distributed edge jitter.
+*
+* Parameters:
+*  amplitude: largest jitter in ticks
+*
+* Return:
+*  double: jitter in ticks, between -amplitude and amplitude
+*
+*******************************************************************************/
+static double test_random_jitter(double amplitude)
+{
+    test_random_state ^= test_random_state << 13;
+    test_random_state ^= test_random_state >> 17;
+    test_random_state ^= test_random_state << 5;
+
+    return amplitude * (((double)test_random_state / 2147483648.0) - 1.0);
+}
+
+/*******************************************************************************
+* Function Name: test_score
+********************************************************************************
+* Summary:
+*  Finds the delay that aligns an output best with the true sector times and
+*  returns the RMS error without delay together with that delay.
+*
+* Parameters:
+*  output: sector time output after each event
+*  length: number of sector times
+*
+* Return:
+*  test_score_t: RMS error and latency
+*
+*******************************************************************************/
+static test_score_t test_score(const double *output, uint32_t length)
+{
+    test_score_t score = { 0.0, 0U };
+    double best = INFINITY;
+    double sum;
+    double error;
+    uint32_t delay;
+    uint32_t k;
+
+    for (delay = 0U; delay <= TEST_MAX_LATENCY; delay++)
+    {
+        sum = 0.0;
+        for (k = TEST_SETTLE; k < length; k++)
+        {
+            error = output[k] - test_truth[k - delay];
+            sum += error * error;
+        }
+        sum = sqrt(sum / (double)(length - TEST_SETTLE));
+        if (delay == 0U)
+        {
+            score.rms = sum;
+        }
+        if (sum < best)
+        {
+            best = sum;
+            score.latency = delay;
+        }
+    }
+
+    return score;
+}
+
+/*******************************************************************************
+* Function Name: test_replay
+********************************************************************************
+* Summary:
+*  Replays the measured sector times through the estimator and prints the
+*  scores of the raw and the estimated sector time.
+*
+* Parameters:
+*  name: name of the trace
+*  length: number of sector times in test_measured and test_truth
+*  kalman: destination of the score of the estimate
+*
+* Return:
+*  test_score_t: score of the raw sector times
+*
+*******************************************************************************/
+static test_score_t test_replay(const char *name, uint32_t length, test_score_t *kalman)
+{
+    test_score_t raw;
+    uint32_t k;
+
+    hall_kalman_init();
+    for (k = 0U; k < length; k++)
+    {
+        hall_kalman_update(test_measured[k]);
+        test_estimate[k] = (double)hall_kalman_get_sector_ticks();
+        test_raw[k] = (double)test_measured[k];
+    }
+
+    raw = test_score(test_raw, length);
+    *kalman = test_score(test_estimate, length);
+    printf("%-24s raw: %8.2f ticks rms, %2lu sectors late; Kalman: %8.2f ticks rms, %2lu sectors late\n",
+            name, raw.rms, (unsigned long)raw.latency, kalman->rms, (unsigned long)kalman->latency);
+
+    return raw;
+}
+
+/*******************************************************************************
+* Function Name: test_synthetic
+********************************************************************************
+* Summary:
+*  Builds a trace from true sector times and jittered edges and replays it.
+*
+* Parameters:
+*  name: name of the trace
+*  start: true sector time at the start in ticks
+*  end: true sector time at the end in ticks
+*  step: the sector time jumps from start to end in the middle of the trace
+*        if true, and changes linearly otherwise
+*  jitter: largest edge jitter in ticks
+*  kalman: destination of the score of the estimate
+*
+* Return:
+*  test_score_t: score of the raw sector times
+*
+*******************************************************************************/
+static test_score_t test_synthetic(const char *name, double start, double end, bool step,
+                                   double jitter, test_score_t *kalman)
+{
+    double previous_jitter = 0.0;
+    double edge_jitter;
+    uint32_t k;
+
+    for (k = 0U; k < TEST_TRACE_LENGTH; k++)
+    {
+        if (step)
+        {
+            test_truth[k] = (k < (TEST_TRACE_LENGTH / 2U)) ? start : end;
+        }
+        else
+        {
+            test_truth[k] = start + (((end - start) * k) / (TEST_TRACE_LENGTH - 1U));
+        }
+
+        /* The capture measures the time between two jittered edges */
+        edge_jitter = test_random_jitter(jitter);
+        test_measured[k] = (uint32_t)lround(test_truth[k] + edge_jitter - previous_jitter);
+        previous_jitter = edge_jitter;
+    }
+
+    return test_replay(name, TEST_TRACE_LENGTH, kalman);
+}
+
+/*******************************************************************************
+* Function Name: test_recorded
+********************************************************************************
+* Summary:
+*  Replays a recorded trace, one sector time in ticks per line. A recorded
+*  trace has no ground truth, so the centred mean of the surrounding sector
+*  times serves as the reference.
+*
+* Parameters:
+*  path: trace file
+*
+* Return:
+*  int: exit status
+*
+*******************************************************************************/
+static int test_recorded(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    test_score_t kalman;
+    unsigned long value;
+    uint32_t length = 0U;
+    uint32_t k;
+    uint32_t i;
+
+    if (file == NULL)
+    {
+        perror(path);
+        return 1;
+    }
+    while ((length < TEST_TRACE_LENGTH) && (fscanf(file, "%lu", &value) == 1))
+    {
+        test_measured[length] = (uint32_t)value;
+        length++;
+    }
+    fclose(file);
+
+    if (length <= (TEST_SETTLE + TEST_REFERENCE_SPAN))
+    {
+        printf("%s: at least %u sector times needed\n", path, TEST_SETTLE + TEST_REFERENCE_SPAN + 1U);
+        return 1;
+    }
+
+    for (k = 0U; k < length; k++)
+    {
+        uint32_t first = (k > TEST_REFERENCE_SPAN) ? (k - TEST_REFERENCE_SPAN) : 0U;
+        uint32_t last = ((k + TEST_REFERENCE_SPAN) < length) ? (k + TEST_REFERENCE_SPAN) : (length - 1U);
+
+        test_truth[k] = 0.0;
+        for (i = first; i <= last; i++)
+        {
+            test_truth[k] += (double)test_measured[i];
+        }
+        test_truth[k] /= (double)(last - first + 1U);
+    }
+
+    (void)test_replay(path, length, &kalman);
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    test_score_t raw;
+    test_score_t kalman;
+
+    if (argc > 1)
+    {
+        return test_recorded(argv[1]);
+    }
+
+    /* Constant speed: the estimate must remove most of the edge jitter */
+    raw = test_synthetic("constant speed", 1000.0, 1000.0, false, 20.0, &kalman);
+    TEST_CHECK(kalman.rms < (raw.rms / 3.0));
+    TEST_CHECK(kalman.latency == 0U);
+
+    /* Run-up from 4000 to 500 ticks: the slope state follows the ramp */
+    raw = test_synthetic("acceleration ramp", 4000.0, 500.0, false, 20.0, &kalman);
+    TEST_CHECK(kalman.rms < (raw.rms / 3.0));
+    TEST_CHECK(kalman.latency <= 1U);
+
+    /* Load step: the estimate settles within a few sectors */
+    raw = test_synthetic("load step", 1000.0, 1500.0, true, 20.0, &kalman);
+    TEST_CHECK(kalman.latency <= 4U);
+
+    /* Between events the prediction follows the model, and a sector that
+     * already lasts longer stretches it */
+    TEST_CHECK(labs((long)hall_kalman_predict(0U) - 1500L) <= 5L);
+    TEST_CHECK(hall_kalman_predict(5000U) == 5000U);
+
+    /* No estimate before the first event */
+    hall_kalman_init();
+    TEST_CHECK(hall_kalman_predict(100U) == 0U);
+    TEST_CHECK(hall_kalman_get_sector_ticks() == 0U);
+
+    return test_result((UC_FAMILY == XMC4) ? "test_hall_kalman (full filter, float)" :
+                       "test_hall_kalman (steady-state filter, fixed point)");
+}
@@ -0,0 +1,258 @@
+/*******************************************************************************
+* File Name:   test_hall_order.c
+*
+* Description: Host test of the order tracking profile in both directions of
+*              rotation, with several pole pairs.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "cybsp.h"
+#include "hall_order.h"
+#include "hall_placement.h"
+#include "test.h"
+#include <stdlib.h>
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Number of profiles checked in each direction */
+#define TEST_PROFILES                       (3U)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+#if (HALL_SENSOR_PLACEMENT == HALL_PLACEMENT_TWO_SENSOR)
+/* Hall code of every sector of the electrical period */
+static const uint8_t test_codes[HALL_SECTORS_PER_PERIOD] = { 3U, 2U, 2U, 0U, 1U, 1U };
+#else
+static const uint8_t test_codes[HALL_SECTORS_PER_PERIOD] = { 3U, 2U, 6U, 4U, 5U, 1U };
+#endif
+
+/* Time of every sector of the revolution, and the time each slot of the
+ * profile should see: the halves of a code of two sectors are equal */
+static uint32_t test_ticks[HALL_ORDER_SECTORS_PER_REV];
+static uint32_t test_slot_ticks[HALL_ORDER_SECTORS_PER_REV];
+
+/* Rotor position as sector of the revolution, and time in the current code */
+static uint32_t test_sector;
+static uint32_t test_code_ticks;
+
+/*******************************************************************************
+* Function Name: test_init_ticks
+********************************************************************************
+* Summary:
+*  Sets a different time for every sector of the revolution, so that a slot
+*  of the wrong sector, pole pair or direction shows in the profile.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_init_ticks(void)
+{
+    uint32_t i;
+
+    for (i = 0U; i < HALL_ORDER_SECTORS_PER_REV; i++)
+    {
+        test_ticks[i] = 2000U + ((i * 37U) % 11U) * 20U + (i * 3U);
+    }
+    for (i = 0U; i < HALL_ORDER_SECTORS_PER_REV; i++)
+    {
+        uint32_t next = (i + 1U) % HALL_ORDER_SECTORS_PER_REV;
+        uint32_t prev = (i + HALL_ORDER_SECTORS_PER_REV - 1U) % HALL_ORDER_SECTORS_PER_REV;
+
+        test_slot_ticks[i] = test_ticks[i];
+        if (hall_placement_get_span(test_codes[i % HALL_SECTORS_PER_PERIOD]) > 1U)
+        {
+            if (test_codes[next % HALL_SECTORS_PER_PERIOD] == test_codes[i % HALL_SECTORS_PER_PERIOD])
+            {
+                test_slot_ticks[i] = (test_ticks[i] + test_ticks[next]) / 2U;
+            }
+            else
+            {
+                test_slot_ticks[i] = (test_ticks[prev] + test_ticks[i]) / 2U;
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: test_check_profile
+********************************************************************************
+* Summary:
+*  Checks a profile against the sector times. The slot of sector 0 must be
+*  slot 0 before the reversal. After the wrong hall event of the reversal the
+*  pole pair of the rotor is not known, so any shift by whole pole pairs is
+*  accepted there.
+*
+* Parameters:
+*  deviation: profile returned by hall_order_get_profile()
+*  any_pole_pair: true to accept a shift by whole pole pairs
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_check_profile(const int16_t *deviation, bool any_pole_pair)
+{
+    uint64_t total = 0U;
+    uint32_t matches = 0U;
+    uint32_t shift;
+    uint32_t i;
+
+    for (i = 0U; i < HALL_ORDER_SECTORS_PER_REV; i++)
+    {
+        total += test_slot_ticks[i];
+    }
+
+    for (shift = 0U; shift < HALL_MOTOR_POLE_PAIRS; shift++)
+    {
+        bool match = true;
+
+        for (i = 0U; i < HALL_ORDER_SECTORS_PER_REV; i++)
+        {
+            uint32_t sector = (i + (shift * HALL_SECTORS_PER_PERIOD)) % HALL_ORDER_SECTORS_PER_REV;
+            double expected = 1000.0 * ((test_slot_ticks[sector] * (double)HALL_ORDER_SECTORS_PER_REV / total) - 1.0);
+
+            if (abs((int)(deviation[i] - (int)(expected + ((expected < 0.0) ? -0.5 : 0.5)))) > 1)
+            {
+                match = false;
+            }
+        }
+        if (match)
+        {
+            matches++;
+        }
+        if (!any_pole_pair)
+        {
+            break;
+        }
+    }
+
+    TEST_CHECK(matches == 1U);
+}
+
+/*******************************************************************************
+* Function Name: test_run
+********************************************************************************
+* Summary:
+*  Turns the rotor sector by sector and passes every change of the hall code
+*  to the order tracking like the correct hall event interrupt: the sector
+*  time of the code left, halved for a code of two sectors, then the new code.
+*  The first change after a reversal is a wrong hall event instead.
+*
+* Parameters:
+*  reverse: direction of rotation
+*  reversal: true if the rotor turns back at the first sector
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_run(bool reverse, bool reversal)
+{
+    int16_t deviation[HALL_ORDER_SECTORS_PER_REV];
+    uint32_t profiles = 0U;
+    uint32_t profile;
+    uint32_t steps = 0U;
+    bool wrong_pending = reversal;
+    uint8_t code;
+    uint8_t new_code;
+    uint32_t span;
+
+    while ((profiles < TEST_PROFILES) && (steps < (HALL_ORDER_SECTORS_PER_REV * HALL_ORDER_REVOLUTIONS * 8U)))
+    {
+        code = test_codes[test_sector % HALL_SECTORS_PER_PERIOD];
+        test_code_ticks += reversal ? 0U : test_ticks[test_sector];
+        reversal = false;
+        test_sector = (test_sector + (reverse ? (HALL_ORDER_SECTORS_PER_REV - 1U) : 1U)) % HALL_ORDER_SECTORS_PER_REV;
+        steps++;
+
+        new_code = test_codes[test_sector % HALL_SECTORS_PER_PERIOD];
+        if (new_code == code)
+        {
+            continue;
+        }
+
+        if (wrong_pending)
+        {
+            hall_order_reset();
+            wrong_pending = false;
+        }
+        else
+        {
+            span = hall_placement_get_span(code);
+            if (span > 1U)
+            {
+                test_code_ticks >>= 1U;
+                hall_order_update(test_code_ticks);
+            }
+            hall_order_update(test_code_ticks);
+            hall_order_set_code(hall_placement_to_canonical(new_code), hall_placement_get_span(new_code));
+        }
+        test_code_ticks = 0U;
+
+        if (hall_order_get_profile(deviation, &profile))
+        {
+            profiles++;
+            test_check_profile(deviation, reverse);
+        }
+    }
+
+    TEST_CHECK(profiles == TEST_PROFILES);
+}
+
+int main(void)
+{
+    test_init_ticks();
+    hall_order_reset();
+
+    /* Start at sector 0, so the slots are numbered from the start position */
+    test_sector = 0U;
+    test_code_ticks = 0U;
+    hall_order_set_code(hall_placement_to_canonical(test_codes[0]), hall_placement_get_span(test_codes[0]));
+    test_run(false, false);
+
+    /* Turn back; the rotor leaves the current code at its first sector */
+    while (test_codes[(test_sector + HALL_ORDER_SECTORS_PER_REV - 1U) % HALL_SECTORS_PER_PERIOD] ==
+           test_codes[test_sector % HALL_SECTORS_PER_PERIOD])
+    {
+        test_sector = (test_sector + HALL_ORDER_SECTORS_PER_REV - 1U) % HALL_ORDER_SECTORS_PER_REV;
+    }
+    test_run(true, true);
+
+    return test_result("test_hall_order");
+}
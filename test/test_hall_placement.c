@@ -0,0 +1,146 @@
+/*******************************************************************************
+* File Name:   test_hall_placement.c
+*
+* Description: Host test of the simulated hall signals and the hall pattern table of
+*              the selected sensor placement.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "cybsp.h"
+#include "hall_placement.h"
+#include "test.h"
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Steps per electrical period of the simulated rotor */
+#define TEST_STEPS_PER_PERIOD               (360U)
+#define TEST_STEPS_PER_SECTOR               (TEST_STEPS_PER_PERIOD / 6U)
+
+/* Electrical periods simulated */
+#define TEST_PERIODS                        (3U)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* Rising edge of the CCU8 output of HALL_1 to HALL_3 in sectors, giving the
+ * 120 degree sequence 1 -> 3 -> 2 -> 6 -> 4 -> 5 */
+static const uint32_t test_rising_sector[3] = { 5U, 1U, 3U };
+
+/*******************************************************************************
+* Function Name: test_simulated_code
+********************************************************************************
+* Summary:
+*  Returns the hall code at the hall inputs for a rotor position, as the CCU8
+*  timers generate it after configure_hall_simulation(): three square waves
+*  120 degrees apart, with the outputs of HALL_PLACEMENT_SIM_INVERTED
+*  inverted and those of HALL_PLACEMENT_SIM_HELD_LOW held low.
+*
+* Parameters:
+*  step: rotor position in steps of the electrical period
+*
+* Return:
+*  uint8_t: hall code
+*
+*******************************************************************************/
+static uint8_t test_simulated_code(uint32_t step)
+{
+    uint32_t code = 0U;
+    uint32_t phase;
+    uint32_t i;
+
+    for (i = 0U; i < 3U; i++)
+    {
+        phase = (step + TEST_STEPS_PER_PERIOD - (test_rising_sector[i] * TEST_STEPS_PER_SECTOR)) %
+                TEST_STEPS_PER_PERIOD;
+        if (phase < (TEST_STEPS_PER_PERIOD / 2U))
+        {
+            code |= 1U << i;
+        }
+    }
+    code ^= HALL_PLACEMENT_SIM_INVERTED;
+    code &= ~HALL_PLACEMENT_SIM_HELD_LOW;
+
+    return (uint8_t)code;
+}
+
+int main(void)
+{
+    uint8_t patterns[8];
+    uint8_t code;
+    uint8_t previous;
+    uint32_t code_start = 0U;
+    uint32_t first_change = 0U;
+    uint32_t sectors = 0U;
+    uint32_t changes = 0U;
+    uint32_t step;
+
+    hall_placement_get_patterns(patterns);
+    previous = test_simulated_code(0U);
+    TEST_CHECK(hall_placement_is_valid(previous));
+
+    /* Every change of the simulated code must be a correct hall event, and
+     * every code must last the sectors it covers */
+    for (step = 1U; step <= (TEST_PERIODS * TEST_STEPS_PER_PERIOD); step++)
+    {
+        code = test_simulated_code(step);
+        if (code == previous)
+        {
+            continue;
+        }
+
+        TEST_CHECK(hall_placement_is_valid(code));
+        TEST_CHECK((patterns[previous] & 0x07U) == previous);
+        TEST_CHECK((patterns[previous] >> 3U) == code);
+        if (changes != 0U)
+        {
+            TEST_CHECK((step - code_start) == (hall_placement_get_span(previous) * TEST_STEPS_PER_SECTOR));
+            if (step <= (first_change + ((TEST_PERIODS - 1U) * TEST_STEPS_PER_PERIOD)))
+            {
+                sectors += hall_placement_get_span(previous);
+            }
+        }
+        else
+        {
+            first_change = step;
+        }
+        changes++;
+        code_start = step;
+        previous = code;
+    }
+
+    /* The codes cover six sectors per electrical period */
+    TEST_CHECK(sectors == ((TEST_PERIODS - 1U) * 6U));
+
+    return test_result("test_hall_placement");
+}
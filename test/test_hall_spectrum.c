@@ -0,0 +1,194 @@
+/*******************************************************************************
+* File Name:   test_hall_spectrum.c
+*
+* Description: Host test of the speed ripple spectrum with synthetic ripple at
+*              constant and changing speed.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "cybsp.h"
+#include "hall_spectrum.h"
+#include "hall_speed.h"
+#include "test.h"
+#include <math.h>
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Blocks analysed per test case; the first two are skipped while the grid
+ * step settles */
+#define TEST_BLOCKS                         (12U)
+#define TEST_SKIPPED_BLOCKS                 (2U)
+
+/* Allowed error relative to the expected ripple, and absolute: one step of
+ * the reported permille values */
+#define TEST_RELATIVE_TOLERANCE             (0.03)
+#define TEST_ABSOLUTE_TOLERANCE             (1.0)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static const uint8_t test_orders[HALL_SPECTRUM_NUM_ORDERS] = HALL_SPECTRUM_ORDERS;
+
+/*******************************************************************************
+* Function Name: test_ripple
+********************************************************************************
+* Summary:
+*  Returns the relative ripple of the synthetic sector speeds at an order.
+*
+* Parameters:
+*  order: mechanical order
+*
+* Return:
+*  double: ripple amplitude relative to the mean speed
+*
+*******************************************************************************/
+static double test_ripple(uint32_t order)
+{
+    return (order == 1U) ? 0.02 : ((order == 2U) ? 0.01 : 0.0);
+}
+
+/*******************************************************************************
+* Function Name: test_expected
+********************************************************************************
+* Summary:
+*  Returns the ripple the analysis should report. Holding the speed of each
+*  sector over the sector attenuates order n by sinc(n * w / 2) for the
+*  sector angle w, and averaging over the grid intervals by sinc(n * g / 2)
+*  for the grid step angle g.
+*
+* Parameters:
+*  order: mechanical order
+*
+* Return:
+*  double: expected ripple in permille
+*
+*******************************************************************************/
+static double test_expected(uint32_t order)
+{
+    double half_sector = M_PI / (HALL_SECTORS_PER_PERIOD * HALL_MOTOR_POLE_PAIRS);
+    double half_step = M_PI / HALL_SPECTRUM_SAMPLES_PER_REV;
+    double sinc = (sin(order * half_sector) / (order * half_sector)) *
+                  (sin(order * half_step) / (order * half_step));
+
+    return 1000.0 * test_ripple(order) * sinc;
+}
+
+/*******************************************************************************
+* Function Name: test_motor
+********************************************************************************
+* Summary:
+*  Runs a synthetic motor through the analysis and checks the reported
+*  ripple of every block. The speed of sector k of a revolution of S sectors
+*  is v * (1 + sum of a(n) * cos(2 pi n k / S)).
+*
+* Parameters:
+*  sector_ticks: mean sector time at the start in speed timer ticks
+*  speed_change: relative speed change per revolution
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_motor(double sector_ticks, double speed_change)
+{
+    const double sector_angle = (2.0 * M_PI) / (HALL_SECTORS_PER_PERIOD * HALL_MOTOR_POLE_PAIRS);
+    double speed = sector_angle / sector_ticks;
+    double angle = 0.0;
+    double time;
+    double local;
+    double worst[HALL_SPECTRUM_NUM_ORDERS] = { 0.0 };
+    hall_spectrum_result_t result;
+    uint32_t blocks = 0U;
+    uint32_t ticks;
+    uint32_t i;
+
+    hall_spectrum_init();
+
+    while (blocks < TEST_BLOCKS)
+    {
+        local = 1.0;
+        for (i = 1U; i <= 6U; i++)
+        {
+            local += test_ripple(i) * cos(i * angle);
+        }
+        time = sector_angle / (speed * local);
+        angle += sector_angle;
+        speed *= 1.0 + ((speed_change * sector_angle) / (2.0 * M_PI));
+
+        ticks = (uint32_t)lround(time);
+        if (hall_spectrum_process(&ticks, 1U))
+        {
+            blocks++;
+            hall_spectrum_get_result(&result);
+            TEST_CHECK(result.block == blocks);
+            if (blocks > TEST_SKIPPED_BLOCKS)
+            {
+                for (i = 0U; i < HALL_SPECTRUM_NUM_ORDERS; i++)
+                {
+                    double expected = test_expected(test_orders[i]);
+                    double error = fabs(result.ripple_permille[i] - expected);
+
+                    TEST_CHECK(error <= ((expected * TEST_RELATIVE_TOLERANCE) + TEST_ABSOLUTE_TOLERANCE));
+                    if (error > worst[i])
+                    {
+                        worst[i] = error;
+                    }
+                }
+            }
+        }
+    }
+
+    printf("%5.0f ticks per sector, %+4.1f%% speed per revolution:", sector_ticks, speed_change * 100.0);
+    for (i = 0U; i < HALL_SPECTRUM_NUM_ORDERS; i++)
+    {
+        printf(" order %u %4.1f +-%3.1f permille", test_orders[i], test_expected(test_orders[i]), worst[i]);
+    }
+    printf("\n");
+}
+
+int main(void)
+{
+    /* Constant speed. At high speed, the rounding of the sector times to
+     * whole timer ticks repeats every revolution and adds its own ripple */
+    test_motor(1000.0, 0.0);
+    test_motor(5000.0, 0.0);
+    test_motor(20000.0, 0.0);
+
+    /* Slow run-up and run-down: the orders move off the bins by up to half
+     * a bin and the window scalloping is corrected */
+    test_motor(2000.0, 0.005);
+    test_motor(1000.0, -0.005);
+
+    return test_result("test_hall_spectrum");
+}
@@ -0,0 +1,168 @@
+/*******************************************************************************
+* File Name:   test_hall_speed.c
+*
+* Description: Host test of the reciprocal division and the speed conversion.
+*              Run with --exhaustive to check every 32-bit divisor (several
+*              minutes).
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "cybsp.h"
+#include "hall_speed.h"
+#include "test.h"
+#include <string.h>
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Random dividend and divisor pairs checked in the default run */
+#define TEST_RANDOM_PAIRS                   (10000000U)
+
+/* Divisors checked on both sides of every power of two */
+#define TEST_POWER_SPAN                     (256U)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static uint32_t test_random_state = 12345U;
+
+/*******************************************************************************
+* Function Name: test_random
+********************************************************************************
+* Summary:
+*  Returns the next value of a 32-bit xorshift generator.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t: pseudo random value
+*
+*******************************************************************************/
+static uint32_t test_random(void)
+{
+    test_random_state ^= test_random_state << 13;
+    test_random_state ^= test_random_state >> 17;
+    test_random_state ^= test_random_state << 5;
+
+    return test_random_state;
+}
+
+/*******************************************************************************
+* Function Name: test_divisor
+********************************************************************************
+* Summary:
+*  Checks one divisor against the dividends that are hardest for a reciprocal
+*  estimate: the largest one and those just below and at multiples of it.
+*
+* Parameters:
+*  divisor: divisor to check, not zero
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_divisor(uint32_t divisor)
+{
+    const uint32_t largest_multiple = (0xFFFFFFFFU / divisor) * divisor;
+    const uint32_t dividends[] =
+    {
+        0U, 1U, divisor - 1U, divisor, (divisor * 2U) - 1U, largest_multiple,
+        largest_multiple - 1U, 0xFFFFFFFFU, test_random()
+    };
+    uint32_t i;
+
+    for (i = 0U; i < (sizeof(dividends) / sizeof(dividends[0])); i++)
+    {
+        TEST_CHECK(hall_speed_udiv_reciprocal(dividends[i], divisor) == (dividends[i] / divisor));
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const uint32_t rpm_numerator = (uint32_t)(60000000000ULL /
+            ((uint64_t)HALL_SECTORS_PER_PERIOD * HALL_MOTOR_POLE_PAIRS * HALL_SPEED_TIMER_TICK_NS));
+    uint64_t divisor;
+    uint32_t power;
+    uint32_t offset;
+    uint32_t i;
+
+    if ((argc > 1) && (strcmp(argv[1], "--exhaustive") == 0))
+    {
+        for (divisor = 1U; divisor <= 0xFFFFFFFFU; divisor++)
+        {
+            test_divisor((uint32_t)divisor);
+        }
+    }
+    else
+    {
+        /* Every sector time the 16-bit speed timer can capture */
+        for (divisor = 1U; divisor <= 0xFFFFU; divisor++)
+        {
+            test_divisor((uint32_t)divisor);
+            TEST_CHECK(hall_speed_udiv_reciprocal(rpm_numerator, (uint32_t)divisor) ==
+                       (rpm_numerator / (uint32_t)divisor));
+        }
+
+        /* Both sides of every power of two, where the normalisation changes */
+        for (power = 16U; power < 32U; power++)
+        {
+            for (offset = 0U; offset < TEST_POWER_SPAN; offset++)
+            {
+                test_divisor((1U << power) + offset);
+                test_divisor((1U << power) - offset - 1U);
+            }
+        }
+        test_divisor(0xFFFFFFFFU);
+
+        /* Random pairs with divisors of random magnitude */
+        for (i = 0U; i < TEST_RANDOM_PAIRS; i++)
+        {
+            uint32_t dividend = test_random();
+            uint32_t divisor_random = test_random() >> (test_random() & 31U);
+
+            if (divisor_random != 0U)
+            {
+                TEST_CHECK(hall_speed_udiv_reciprocal(dividend, divisor_random) == (dividend / divisor_random));
+            }
+        }
+    }
+
+    /* The speed conversion itself */
+    TEST_CHECK(hall_speed_get_rpm(0U) == 0U);
+    TEST_CHECK(hall_speed_get_rpm(1U) == rpm_numerator);
+    TEST_CHECK(hall_speed_get_rpm(1000U) == (rpm_numerator / 1000U));
+    TEST_CHECK(hall_speed_get_rpm(0xFFFFU) == (rpm_numerator / 0xFFFFU));
+
+    return test_result("test_hall_speed");
+}
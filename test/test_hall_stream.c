@@ -0,0 +1,288 @@
+/*******************************************************************************
+* File Name:   test_hall_stream.c
+*
+* Description: Host round-trip test of the edge stream: the records encoded by
+*              hall_stream.c are decoded with the host decoder of the tools folder,
+*              also across dropped records, and the compression of a steady signal is
+*              checked.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "cybsp.h"
+#include "hall_stream.h"
+#include "hall_stream_decoder.h"
+#include "test.h"
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+#define TEST_RECORDS                        (20000U)
+
+/* Every record takes at most a keyframe and the interpolation marker */
+#define TEST_CAPTURE_SIZE                   (TEST_RECORDS * (HALL_STREAM_KEYFRAME_LENGTH + 1U))
+
+/* Steady sector time and its noise in speed timer ticks */
+#define TEST_SECTOR_TICKS                   (5000U)
+#define TEST_NOISE_TICKS                    (20U)
+
+/* Largest bytes per edge of the steady signal, in percent */
+#define TEST_MAX_BYTES_PER_EDGE             (120U)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static uint32_t test_random_state = 2463534242U;
+
+/* Records that entered the stream, and the stream bytes read */
+static hall_stream_record_t test_expected[TEST_RECORDS];
+static uint8_t test_capture[TEST_CAPTURE_SIZE];
+static uint32_t test_expected_count;
+static uint32_t test_capture_count;
+
+/* Time base of the keyframes */
+static uint32_t test_time_ms;
+
+/*******************************************************************************
+* Function Name: test_random
+********************************************************************************
+* Summary:
+*  Returns the next value of a 32-bit xorshift generator.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t: pseudo random value
+*
+*******************************************************************************/
+static uint32_t test_random(void)
+{
+    test_random_state ^= test_random_state << 13;
+    test_random_state ^= test_random_state >> 17;
+    test_random_state ^= test_random_state << 5;
+
+    return test_random_state;
+}
+
+/*******************************************************************************
+* Function Name: test_drain
+********************************************************************************
+* Summary:
+*  Reads all buffered stream bytes into the capture.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_drain(void)
+{
+    test_capture_count += hall_stream_read(&test_capture[test_capture_count],
+                                           TEST_CAPTURE_SIZE - test_capture_count);
+}
+
+/*******************************************************************************
+* Function Name: test_encode
+********************************************************************************
+* Summary:
+*  Encodes a random mix of noisy sector times, jumps over the full 32-bit
+*  range, interpolated sector times, wrong hall events and chunk starts. The
+*  stream is read rarely in a part of the run, so that records are dropped.
+*  Every record that was not dropped is expected from the decoder.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_encode(void)
+{
+    hall_stream_stats_t stats;
+    hall_stream_record_t *record;
+    uint32_t dropped = 0U;
+    uint32_t ticks;
+    uint32_t i;
+
+    hall_stream_reset();
+    test_expected_count = 0U;
+    test_capture_count = 0U;
+
+    for (i = 0U; i < TEST_RECORDS; i++)
+    {
+        uint32_t r = test_random();
+
+        record = &test_expected[test_expected_count];
+        record->keyframe = false;
+        record->time_ms = test_time_ms;
+        if ((r % 50U) == 0U)
+        {
+            record->type = HALL_STREAM_RECORD_WHE;
+            record->sector_ticks = 0U;
+            record->interpolated = false;
+            hall_stream_push_whe();
+        }
+        else
+        {
+            record->type = HALL_STREAM_RECORD_EDGE;
+            record->sector_ticks = ((r % 499U) == 0U) ? test_random() :
+                                   (TEST_SECTOR_TICKS + (test_random() % (2U * TEST_NOISE_TICKS)) - TEST_NOISE_TICKS);
+            record->interpolated = ((r % 97U) == 0U);
+            hall_stream_push(record->sector_ticks, record->interpolated);
+        }
+
+        hall_stream_get_stats(&stats);
+        if (stats.dropped == dropped)
+        {
+            test_expected_count++;
+        }
+        dropped = stats.dropped;
+
+        if ((i % 300U) == 299U)
+        {
+            (void)hall_stream_start_chunk();
+        }
+
+        /* Read after every record, in the middle third only after every 400th */
+        if ((i < (TEST_RECORDS / 3U)) || (i > ((2U * TEST_RECORDS) / 3U)) || ((i % 400U) == 0U))
+        {
+            test_drain();
+        }
+        for (ticks = (r >> 8) & 3U; ticks != 0U; ticks--)
+        {
+            hall_stream_tick();
+            test_time_ms++;
+        }
+    }
+    test_drain();
+
+    TEST_CHECK(dropped != 0U);
+    TEST_CHECK(stats.bytes == test_capture_count);
+}
+
+/*******************************************************************************
+* Function Name: test_decode
+********************************************************************************
+* Summary:
+*  Decodes the capture and compares every record with the expected one. The
+*  time of a keyframe must be the time of its edge.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_decode(void)
+{
+    hall_stream_decoder_t decoder;
+    hall_stream_record_t record;
+    hall_stream_stats_t stats;
+    uint32_t decoded = 0U;
+    uint32_t keyframes = 0U;
+    uint32_t i;
+
+    hall_stream_get_stats(&stats);
+    hall_stream_decoder_init(&decoder);
+    for (i = 0U; i < test_capture_count; i++)
+    {
+        if (!hall_stream_decode_byte(&decoder, test_capture[i], &record))
+        {
+            continue;
+        }
+        if (!TEST_CHECK(decoded < test_expected_count))
+        {
+            break;
+        }
+
+        TEST_CHECK(record.type == test_expected[decoded].type);
+        TEST_CHECK(record.sector_ticks == test_expected[decoded].sector_ticks);
+        TEST_CHECK(record.interpolated == test_expected[decoded].interpolated);
+        if (record.keyframe)
+        {
+            TEST_CHECK(record.time_ms == test_expected[decoded].time_ms);
+            keyframes++;
+        }
+        decoded++;
+    }
+
+    TEST_CHECK(decoded == test_expected_count);
+    TEST_CHECK(keyframes == stats.keyframes);
+    TEST_CHECK(decoder.errors == 0U);
+}
+
+/*******************************************************************************
+* Function Name: test_compression
+********************************************************************************
+* Summary:
+*  Checks the bytes per edge of a steady sector time with noise, including
+*  the keyframes.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_compression(void)
+{
+    hall_stream_stats_t stats;
+    uint32_t i;
+
+    hall_stream_reset();
+    test_capture_count = 0U;
+    for (i = 0U; i < TEST_RECORDS; i++)
+    {
+        hall_stream_push(TEST_SECTOR_TICKS + (test_random() % (2U * TEST_NOISE_TICKS)) - TEST_NOISE_TICKS, false);
+        test_drain();
+    }
+
+    hall_stream_get_stats(&stats);
+    TEST_CHECK(stats.dropped == 0U);
+    TEST_CHECK((stats.bytes * 100U) <= (stats.edges * TEST_MAX_BYTES_PER_EDGE));
+}
+
+int main(void)
+{
+    test_time_ms = 0U;
+    test_encode();
+    test_decode();
+    test_compression();
+
+    return test_result("test_hall_stream");
+}
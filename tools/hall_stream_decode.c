@@ -0,0 +1,305 @@
+/*******************************************************************************
+* File Name:   hall_stream_decode.c
+*
+* Description: Decodes the edge stream from a terminal log of the example. Reads the
+*              "stream" lines of the report and prints one line per record,
+*              or a summary, optionally from the first keyframe at or after a
+*              given time.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "hall_stream_decoder.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Prefix of the report lines that carry the stream bytes in hex */
+#define STREAM_LINE_PREFIX                  "stream "
+
+/* Longest line of the terminal log */
+#define LINE_SIZE                           (1024U)
+
+/*******************************************************************************
+* Data structure and enumeration
+*******************************************************************************/
+typedef struct
+{
+    unsigned long edges;
+    unsigned long keyframes;
+    unsigned long interpolated;
+    unsigned long wrong_events;
+    uint32_t min_ticks;
+    uint32_t max_ticks;
+    uint64_t sum_ticks;
+} summary_t;
+
+/*******************************************************************************
+* Function Name: hex_digit
+********************************************************************************
+* Summary:
+*  Converts a hex digit.
+*
+* Parameters:
+*  c: character
+*
+* Return:
+*  int: value of the digit, -1 if c is no hex digit
+*
+*******************************************************************************/
+static int hex_digit(char c)
+{
+    if ((c >= '0') && (c <= '9'))
+    {
+        return c - '0';
+    }
+    if ((c >= 'a') && (c <= 'f'))
+    {
+        return c - 'a' + 10;
+    }
+    if ((c >= 'A') && (c <= 'F'))
+    {
+        return c - 'A' + 10;
+    }
+
+    return -1;
+}
+
+/*******************************************************************************
+* Function Name: print_record
+********************************************************************************
+* Summary:
+*  Prints a decoded record: "edge <ticks>" with " keyframe <ms>" and
+*  " interpolated" where they apply, or "whe".
+*
+* Parameters:
+*  record: decoded record
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void print_record(const hall_stream_record_t *record)
+{
+    if (record->type == HALL_STREAM_RECORD_WHE)
+    {
+        printf("whe\n");
+        return;
+    }
+
+    printf("edge %lu", (unsigned long)record->sector_ticks);
+    if (record->keyframe)
+    {
+        printf(" keyframe %lu", (unsigned long)record->time_ms);
+    }
+    if (record->interpolated)
+    {
+        printf(" interpolated");
+    }
+    printf("\n");
+}
+
+/*******************************************************************************
+* Function Name: add_to_summary
+********************************************************************************
+* Summary:
+*  Counts a decoded record in the summary.
+*
+* Parameters:
+*  summary: summary to update
+*  record: decoded record
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void add_to_summary(summary_t *summary, const hall_stream_record_t *record)
+{
+    if (record->type == HALL_STREAM_RECORD_WHE)
+    {
+        summary->wrong_events++;
+        return;
+    }
+
+    summary->edges++;
+    summary->keyframes += record->keyframe ? 1UL : 0UL;
+    summary->interpolated += record->interpolated ? 1UL : 0UL;
+    summary->sum_ticks += record->sector_ticks;
+    if (record->sector_ticks < summary->min_ticks)
+    {
+        summary->min_ticks = record->sector_ticks;
+    }
+    if (record->sector_ticks > summary->max_ticks)
+    {
+        summary->max_ticks = record->sector_ticks;
+    }
+}
+
+/*******************************************************************************
+* Function Name: print_summary
+********************************************************************************
+* Summary:
+*  Prints the record counts and the sector time range and mean in speed
+*  timer ticks.
+*
+* Parameters:
+*  summary: summary to print
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void print_summary(const summary_t *summary)
+{
+    printf("edges %lu\n", summary->edges);
+    printf("keyframes %lu\n", summary->keyframes);
+    printf("interpolated %lu\n", summary->interpolated);
+    printf("wrong hall events %lu\n", summary->wrong_events);
+    if (summary->edges != 0UL)
+    {
+        printf("sector ticks min %lu max %lu mean %.1f\n",
+               (unsigned long)summary->min_ticks, (unsigned long)summary->max_ticks,
+               (double)summary->sum_ticks / (double)summary->edges);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    hall_stream_decoder_t decoder;
+    hall_stream_record_t record;
+    char line[LINE_SIZE];
+    FILE *input = stdin;
+    summary_t summary = { 0UL, 0UL, 0UL, 0UL, UINT32_MAX, 0U, 0U };
+    unsigned long start_ms = 0UL;
+    bool started = true;
+    bool summarise = false;
+    int arg = 1;
+    unsigned long bytes = 0UL;
+    unsigned long records = 0UL;
+    const char *c;
+    int high;
+    int low;
+
+    while ((arg < argc) && (argv[arg][0] == '-'))
+    {
+        if (strcmp(argv[arg], "-s") == 0)
+        {
+            summarise = true;
+            arg++;
+        }
+        else if ((strcmp(argv[arg], "-t") == 0) && ((arg + 1) < argc))
+        {
+            start_ms = strtoul(argv[arg + 1], NULL, 0);
+            started = false;
+            arg += 2;
+        }
+        else
+        {
+            break;
+        }
+    }
+    if ((argc > (arg + 1)) || ((arg < argc) && (argv[arg][0] == '-')))
+    {
+        fprintf(stderr, "usage: %s [-s] [-t start ms] [terminal log]\n", argv[0]);
+        return 2;
+    }
+    if (argc == (arg + 1))
+    {
+        input = fopen(argv[arg], "r");
+        if (input == NULL)
+        {
+            perror(argv[arg]);
+            return 1;
+        }
+    }
+
+    hall_stream_decoder_init(&decoder);
+    while (fgets(line, sizeof(line), input) != NULL)
+    {
+        /* Skip the other report lines */
+        c = strstr(line, STREAM_LINE_PREFIX);
+        if (c == NULL)
+        {
+            continue;
+        }
+
+        for (c += strlen(STREAM_LINE_PREFIX); ; c += 2)
+        {
+            high = hex_digit(c[0]);
+            low = (high < 0) ? -1 : hex_digit(c[1]);
+            if (low < 0)
+            {
+                break;
+            }
+            bytes++;
+            if (!hall_stream_decode_byte(&decoder, (uint8_t)((high << 4) | low), &record))
+            {
+                continue;
+            }
+
+            /* Every chunk starts with a keyframe, which carries the time */
+            if (!started && record.keyframe && (record.time_ms >= start_ms))
+            {
+                started = true;
+            }
+            if (!started)
+            {
+                continue;
+            }
+            records++;
+            if (summarise)
+            {
+                add_to_summary(&summary, &record);
+            }
+            else
+            {
+                print_record(&record);
+            }
+        }
+    }
+
+    if (input != stdin)
+    {
+        fclose(input);
+    }
+    if (summarise)
+    {
+        print_summary(&summary);
+    }
+    fprintf(stderr, "%lu bytes, %lu records, %lu malformed records skipped\n",
+            bytes, records, (unsigned long)decoder.errors);
+
+    return 0;
+}
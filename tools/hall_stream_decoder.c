@@ -0,0 +1,215 @@
+/*******************************************************************************
+* File Name:   hall_stream_decoder.c
+*
+* Description: Host decoder of the compressed edge stream of hall_stream.c. The
+*              stream is decoded byte by byte, so records may span report lines.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#include "hall_stream_decoder.h"
+#include <string.h>
+
+/*******************************************************************************
+*  Macros
+*******************************************************************************/
+/* Bytes per value of a keyframe */
+#define HALL_STREAM_DECODER_FIELD           (5U)
+
+/* Largest bit position of a varint byte; a longer varint is malformed */
+#define HALL_STREAM_DECODER_MAX_SHIFT       (28U)
+
+/*******************************************************************************
+* Function Name: hall_stream_decoder_error
+********************************************************************************
+* Summary:
+*  Drops the record being received and waits for the next keyframe.
+*
+* Parameters:
+*  decoder: decoder state
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void hall_stream_decoder_error(hall_stream_decoder_t *decoder)
+{
+    decoder->errors++;
+    decoder->synchronised = false;
+    decoder->interpolated = false;
+    decoder->in_keyframe = false;
+    decoder->value = 0U;
+    decoder->shift = 0U;
+}
+
+/*******************************************************************************
+* Function Name: hall_stream_decoder_init
+********************************************************************************
+* Summary:
+*  Resets a decoder. Sector times are decoded from the first keyframe on.
+*
+* Parameters:
+*  decoder: decoder state
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hall_stream_decoder_init(hall_stream_decoder_t *decoder)
+{
+    memset(decoder, 0, sizeof(*decoder));
+}
+
+/*******************************************************************************
+* Function Name: hall_stream_decode_byte
+********************************************************************************
+* Summary:
+*  Decodes the next stream byte. Deltas before the first keyframe are
+*  skipped, as their prediction is unknown. A malformed record, e.g. after
+*  lost bytes, is skipped up to the next keyframe.
+*
+* Parameters:
+*  decoder: decoder state
+*  byte: stream byte
+*  record: destination of the decoded record
+*
+* Return:
+*  bool: true if the byte completed a record
+*
+*******************************************************************************/
+bool hall_stream_decode_byte(hall_stream_decoder_t *decoder, uint8_t byte, hall_stream_record_t *record)
+{
+    uint32_t zigzag;
+
+    if (decoder->in_keyframe)
+    {
+        if ((byte & 0x80U) != 0U)
+        {
+            decoder->value |= (uint32_t)(byte & 0x7FU) << decoder->shift;
+            decoder->shift += 7U;
+            decoder->count++;
+            if (decoder->count == HALL_STREAM_DECODER_FIELD)
+            {
+                decoder->sector_ticks = decoder->value;
+                decoder->value = 0U;
+                decoder->shift = 0U;
+            }
+            else if (decoder->count == (2U * HALL_STREAM_DECODER_FIELD))
+            {
+                record->type = HALL_STREAM_RECORD_EDGE;
+                record->sector_ticks = decoder->sector_ticks;
+                record->interpolated = decoder->interpolated;
+                record->keyframe = true;
+                record->time_ms = decoder->value;
+
+                decoder->prediction = decoder->sector_ticks;
+                decoder->synchronised = true;
+                decoder->interpolated = false;
+                decoder->in_keyframe = false;
+                decoder->value = 0U;
+                decoder->shift = 0U;
+                return true;
+            }
+            else
+            {
+                /* Keyframe field in progress */
+            }
+            return false;
+        }
+
+        /* The keyframe was cut short; the byte starts the next record */
+        hall_stream_decoder_error(decoder);
+    }
+
+    /* Markers are only recognised at the start of a record */
+    if (decoder->shift == 0U)
+    {
+        if (byte == HALL_STREAM_KEYFRAME)
+        {
+            decoder->in_keyframe = true;
+            decoder->count = 0U;
+            return false;
+        }
+        if (byte == HALL_STREAM_WHE)
+        {
+            if (decoder->interpolated)
+            {
+                hall_stream_decoder_error(decoder);
+            }
+            record->type = HALL_STREAM_RECORD_WHE;
+            record->sector_ticks = 0U;
+            record->interpolated = false;
+            record->keyframe = false;
+            record->time_ms = 0U;
+            return true;
+        }
+        if (byte == HALL_STREAM_INTERPOLATED)
+        {
+            if (decoder->interpolated)
+            {
+                hall_stream_decoder_error(decoder);
+            }
+            decoder->interpolated = true;
+            return false;
+        }
+    }
+
+    decoder->value |= (uint32_t)(byte & 0x7FU) << decoder->shift;
+    if ((byte & 0x80U) != 0U)
+    {
+        decoder->shift += 7U;
+        if (decoder->shift > HALL_STREAM_DECODER_MAX_SHIFT)
+        {
+            hall_stream_decoder_error(decoder);
+        }
+        return false;
+    }
+
+    zigzag = decoder->value - HALL_STREAM_DELTA_OFFSET;
+    decoder->value = 0U;
+    decoder->shift = 0U;
+    if (!decoder->synchronised)
+    {
+        decoder->interpolated = false;
+        return false;
+    }
+
+    decoder->prediction += (zigzag >> 1) ^ (0U - (zigzag & 1U));
+    record->type = HALL_STREAM_RECORD_EDGE;
+    record->sector_ticks = decoder->prediction;
+    record->interpolated = decoder->interpolated;
+    record->keyframe = false;
+    record->time_ms = 0U;
+    decoder->interpolated = false;
+
+    return true;
+}
@@ -0,0 +1,80 @@
+/*******************************************************************************
+* File Name:   hall_stream_decoder.h
+*
+* Description: Host decoder of the compressed edge stream of hall_stream.c.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+*
+* Copyright (c) 2022, Infineon Technologies AG
+* All rights reserved.
+*
+* Boost Software License - Version 1.0 - August 17th, 2003
+* Permission is hereby granted, free of charge, to any person or organization
+* obtaining a copy of the software and accompanying documentation covered by
+* this license (the "Software") to use, reproduce, display, distribute,
+* execute, and transmit the Software, and to prepare derivative works of the
+* Software, and to permit third-parties to whom the Software is furnished to
+* do so, all subject to the following:
+*
+* The copyright notices in the Software and this entire statement, including
+* the above license grant, this restriction and the following disclaimer,
+* must be included in all copies of the Software, in whole or in part, and
+* all derivative works of the Software, unless such copies or derivative
+* works are solely in the form of machine-executable object code generatd by
+* a source language processor.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+* SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+* FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+*******************************************************************************/
+
+#ifndef HALL_STREAM_DECODER_H_
+#define HALL_STREAM_DECODER_H_
+
+#include "hall_stream.h"
+
+/*******************************************************************************
+* Data structure and enumeration
+*******************************************************************************/
+typedef enum
+{
+    HALL_STREAM_RECORD_EDGE,        /* Sector time */
+    HALL_STREAM_RECORD_WHE          /* Wrong hall event */
+} hall_stream_record_type_t;
+
+typedef struct
+{
+    hall_stream_record_type_t type;
+    uint32_t sector_ticks;          /* Sector time in speed timer ticks */
+    bool interpolated;              /* Interpolated across a missed edge */
+    bool keyframe;                  /* Sent as keyframe, time_ms is valid */
+    uint32_t time_ms;               /* Time of the edge of a keyframe */
+} hall_stream_record_t;
+
+typedef struct
+{
+    uint32_t prediction;            /* Sector time the next delta is relative to */
+    bool synchronised;              /* A keyframe was decoded */
+    bool interpolated;              /* Interpolation marker received */
+    bool in_keyframe;               /* Receiving the fields of a keyframe */
+    uint32_t count;                 /* Keyframe bytes received */
+    uint32_t value;                 /* Value being received */
+    uint32_t shift;                 /* Bit position of the next seven bits */
+    uint32_t sector_ticks;          /* Sector time of the keyframe */
+    uint32_t errors;                /* Malformed records skipped */
+} hall_stream_decoder_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void hall_stream_decoder_init(hall_stream_decoder_t *decoder);
+bool hall_stream_decode_byte(hall_stream_decoder_t *decoder, uint8_t byte, hall_stream_record_t *record);
+
+#endif /* HALL_STREAM_DECODER_H_ */